@@ -1,13 +1,272 @@
 #include "../../src/ssnp/forward.h"
+#include "../../src/common/dft/dft.h"
+#include "../../src/common/fft/fft.h"
+#include "../../src/common/fft/fft_plan.h"
+#include "../../src/common/tuning.h"
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <cstdlib>
 #include <iostream>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
+// Average milliseconds of one FFT pass over a batch of H x W fields.
+// A one-element readback waits for the queue before and after the timed runs.
+static double timeFFTPass(WebGPUContext& context, FFTPlan& plan, wgpu::Buffer& output, wgpu::Buffer& input, FFTPlan::Pass pass, int runs) {
+    plan.execute(context, output, input, pass);
+    readBack(context, 1, output);
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    {
+        GpuStreamScope stream(context);
+        for (int run = 0; run < runs; run++) {
+            plan.execute(context, output, input, pass);
+        }
+    }
+    readBack(context, 1, output);
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    return std::chrono::duration<double, std::milli>(end - start).count() / runs;
+}
+
+// Compares the forward model with f16 field storage against the f32 path on a weak
+// phase object, reporting the relative L2 and max abs errors of the intensities.
+// Grids from 256 x 256 on are the ones whose unnormalized spectra would overflow f16.
+static void reportF16Accuracy(WebGPUContext& context, int D, int H, int W, const std::vector<float>& res, float na, float n0) {
+    if (setFieldStorage(context, FieldStorage::F16) != FieldStorage::F16) {
+        std::cerr << "f16 storage: adapter has no shader-f16, skipped" << std::endl;
+        return;
+    }
+
+    Tensor3D volume(static_cast<size_t>(D), static_cast<size_t>(H), static_cast<size_t>(W), n0);
+    for (size_t i = 0; i < volume.size(); i++) {
+        volume.data()[i] += 0.01f * std::sin(0.37f * float(i % 97)) * std::cos(0.11f * float(i / 97 % 89));
+    }
+    const std::vector<std::vector<float>> angles(1, std::vector<float>(2, 0.0f));
+
+    auto runForward = [&](FieldStorage storage, double& ms) {
+        setFieldStorage(context, storage);
+        const auto start = std::chrono::high_resolution_clock::now();
+        Tensor3D result = ssnp::forward(context, volume, res, na, angles, n0, 1);
+        ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+        return result;
+    };
+    double f32_ms = 0.0;
+    double f16_ms = 0.0;
+    const Tensor3D reference = runForward(FieldStorage::F32, f32_ms);
+    const Tensor3D reduced = runForward(FieldStorage::F16, f16_ms);
+    setFieldStorage(context, FieldStorage::F32);
+
+    double error_sq = 0.0;
+    double reference_sq = 0.0;
+    double max_error = 0.0;
+    for (size_t i = 0; i < reference.size(); i++) {
+        const double error = double(reduced.data()[i]) - double(reference.data()[i]);
+        error_sq += error * error;
+        reference_sq += double(reference.data()[i]) * double(reference.data()[i]);
+        max_error = std::max(max_error, std::abs(error));
+    }
+    std::cerr << "f16 storage (" << D << "x" << H << "x" << W << "): relative L2 error " << std::sqrt(error_sq / std::max(reference_sq, 1e-30))
+              << ", max abs error " << max_error << " (f32 " << f32_ms << " ms, f16 " << f16_ms << " ms)" << std::endl;
+}
+
+// Checks rfft against the complex fft of the same real fields and irfft(rfft(x)) against
+// x, on the even (packed half-length) and odd (full-length) row paths of the real plans.
+static void reportRealFFTAccuracy(WebGPUContext& context, int H, int W) {
+    for (int cols : {W, W + 1}) {
+        const size_t len = static_cast<size_t>(H) * static_cast<size_t>(cols);
+        const size_t spectrum_cols = static_cast<size_t>(cols / 2 + 1);
+        std::vector<float> real(len);
+        std::vector<float> complex(2 * len, 0.0f);
+        for (size_t i = 0; i < len; i++) {
+            real[i] = std::sin(0.37f * float(i % 97)) * std::cos(0.11f * float(i / 97 % 89));
+            complex[2 * i] = real[i];
+        }
+
+        PooledBuffer realBuffer = acquireBuffer(context, real.data(), sizeof(float) * len);
+        PooledBuffer complexBuffer = acquireBuffer(context, complex.data(), sizeof(float) * 2 * len);
+        PooledBuffer spectrumBuffer = acquireBuffer(context, nullptr, sizeof(float) * 2 * H * spectrum_cols);
+        PooledBuffer fullBuffer = acquireBuffer(context, nullptr, sizeof(float) * 2 * len);
+        PooledBuffer roundTripBuffer = acquireBuffer(context, nullptr, sizeof(float) * len);
+        rfft(context, spectrumBuffer, realBuffer, len, H, cols);
+        fft(context, fullBuffer, complexBuffer, len, H, cols, 0);
+        irfft(context, roundTripBuffer, spectrumBuffer, len, H, cols);
+
+        const std::vector<float> spectrum = readBack(context, 2 * H * spectrum_cols, spectrumBuffer);
+        const std::vector<float> full = readBack(context, 2 * len, fullBuffer);
+        const std::vector<float> roundTrip = readBack(context, len, roundTripBuffer);
+
+        // Half spectrum against the first cols / 2 + 1 columns of the complex transform
+        double spectrum_error = 0.0;
+        double spectrum_peak = 0.0;
+        for (size_t row = 0; row < static_cast<size_t>(H); row++) {
+            for (size_t k = 0; k < 2 * spectrum_cols; k++) {
+                const double expected = full[row * 2 * cols + k];
+                spectrum_error = std::max(spectrum_error, std::abs(double(spectrum[row * 2 * spectrum_cols + k]) - expected));
+                spectrum_peak = std::max(spectrum_peak, std::abs(expected));
+            }
+        }
+        double round_trip_error = 0.0;
+        for (size_t i = 0; i < len; i++) {
+            round_trip_error = std::max(round_trip_error, std::abs(double(roundTrip[i]) - double(real[i])));
+        }
+        std::cerr << "rfft (" << H << "x" << cols << "): max spectrum error " << spectrum_error / std::max(spectrum_peak, 1e-30)
+                  << " of the peak, irfft round trip max abs error " << round_trip_error << std::endl;
+    }
+}
+
+// Deterministic complex test fields, interleaved (re, im)
+static std::vector<float> testField(size_t len) {
+    std::vector<float> field(2 * len);
+    for (size_t i = 0; i < len; i++) {
+        field[2 * i] = std::sin(0.37f * float(i % 97)) * std::cos(0.11f * float(i / 97 % 89));
+        field[2 * i + 1] = std::cos(0.23f * float(i % 53)) - 0.5f;
+    }
+    return field;
+}
+
+// Max abs difference, relative to the largest reference magnitude
+static double relativeError(const std::vector<float>& actual, const std::vector<float>& expected) {
+    double error = 0.0;
+    double peak = 0.0;
+    for (size_t i = 0; i < expected.size(); i++) {
+        error = std::max(error, std::abs(double(actual[i]) - double(expected[i])));
+        peak = std::max(peak, std::abs(double(expected[i])));
+    }
+    return error / std::max(peak, 1e-30);
+}
+
+// Checks fft against the O(N^2) dft_row / dft_col reference on every plan route: six-step
+// rows and tiled-transpose columns, prime (Bluestein) rows and columns, a single column
+// and a non-square 2D shape, in both directions. The 2D shape also runs every FFTNorm,
+// a batch of three fields and an f16 round trip. Returns false if any check fails.
+static bool checkFFTAccuracy(WebGPUContext& context) {
+    // Smallest power-of-2 lines too long for the shared-memory kernel take the six-step route
+    const uint32_t sharedLimit = context.capabilities.maxWorkgroupStorageSize / (4 * sizeof(float));
+    int sixStep = 1;
+    while (uint32_t(sixStep) <= sharedLimit) {
+        sixStep *= 2;
+    }
+
+    struct Case {
+        const char* route;
+        int rows;
+        int cols;
+    };
+    const Case cases[] = {
+        {"six-step rows", 4, sixStep},
+        {"six-step columns", sixStep, 2},
+        {"Bluestein rows", 6, 97},
+        {"Bluestein columns", 101, 10},
+        {"single column", 64, 1},
+        {"non-square 2D", 48, 80},
+    };
+    constexpr double tolerance = 1e-3;
+    constexpr double f16Tolerance = 1e-2;
+
+    bool passed = true;
+    auto report = [&](const std::string& name, double error, double limit) {
+        passed = passed && error <= limit;
+        std::cerr << "fft check " << name << ": max error " << error << " of the peak" << (error <= limit ? "" : " FAILED") << std::endl;
+    };
+
+    // fft with the given norm against the reference, which normalizes like FFTNorm::Backward
+    auto checkAgainstDft = [&](const Case& shape, uint32_t inverse, FFTNorm norm, const std::string& name) {
+        const size_t len = static_cast<size_t>(shape.rows) * static_cast<size_t>(shape.cols);
+        std::vector<float> input = testField(len);
+        PooledBuffer inputBuffer = acquireBuffer(context, input.data(), sizeof(float) * input.size());
+        PooledBuffer fftBuffer = acquireBuffer(context, nullptr, sizeof(float) * input.size());
+        PooledBuffer dftBuffer = acquireBuffer(context, nullptr, sizeof(float) * input.size());
+        fft(context, fftBuffer, inputBuffer, len, shape.rows, shape.cols, inverse, false, norm);
+        dft(context, dftBuffer, inputBuffer, len, shape.rows, shape.cols, inverse);
+
+        std::vector<float> expected = readBack(context, 2 * len, dftBuffer);
+        const float rescale = normScale(norm, inverse != 0, len) / normScale(FFTNorm::Backward, inverse != 0, len);
+        for (float& value : expected) {
+            value *= rescale;
+        }
+        report(name, relativeError(readBack(context, 2 * len, fftBuffer), expected), tolerance);
+    };
+
+    for (const Case& shape : cases) {
+        for (uint32_t inverse : {0u, 1u}) {
+            const std::string name = std::string(shape.route) + " (" + std::to_string(shape.rows) + "x" + std::to_string(shape.cols)
+                + (inverse ? ", inverse)" : ", forward)");
+            checkAgainstDft(shape, inverse, FFTNorm::Backward, name);
+        }
+    }
+
+    const Case& plane = cases[5];
+    const size_t len = static_cast<size_t>(plane.rows) * static_cast<size_t>(plane.cols);
+    const std::string shapeName = " (" + std::to_string(plane.rows) + "x" + std::to_string(plane.cols) + ")";
+    const std::pair<FFTNorm, const char*> norms[] = {{FFTNorm::None, "none"}, {FFTNorm::Forward, "forward"}, {FFTNorm::Ortho, "ortho"}};
+    for (const auto& [norm, normName] : norms) {
+        for (uint32_t inverse : {0u, 1u}) {
+            checkAgainstDft(plane, inverse, norm, std::string("norm ") + normName + (inverse ? " inverse" : " forward") + shapeName);
+        }
+    }
+
+    // A batch of three scaled copies: field b must come out as (b + 1) times the single-field transform
+    {
+        constexpr int batch = 3;
+        const std::vector<float> field = testField(len);
+        std::vector<float> input;
+        for (int b = 0; b < batch; b++) {
+            for (float value : field) {
+                input.push_back(float(b + 1) * value);
+            }
+        }
+        PooledBuffer fieldBuffer = acquireBuffer(context, field.data(), sizeof(float) * field.size());
+        PooledBuffer singleBuffer = acquireBuffer(context, nullptr, sizeof(float) * field.size());
+        PooledBuffer inputBuffer = acquireBuffer(context, input.data(), sizeof(float) * input.size());
+        PooledBuffer batchBuffer = acquireBuffer(context, nullptr, sizeof(float) * input.size());
+        fft(context, singleBuffer, fieldBuffer, len, plane.rows, plane.cols, 0);
+        fft(context, batchBuffer, inputBuffer, batch * len, plane.rows, plane.cols, 0);
+
+        const std::vector<float> single = readBack(context, 2 * len, singleBuffer);
+        std::vector<float> expected;
+        for (int b = 0; b < batch; b++) {
+            for (float value : single) {
+                expected.push_back(float(b + 1) * value);
+            }
+        }
+        report("batch of " + std::to_string(batch) + shapeName, relativeError(readBack(context, 2 * batch * len, batchBuffer), expected), tolerance);
+    }
+
+    // f32 -> f16 spectrum -> f32, orthonormal so the f16 values stay in range
+    if (context.capabilities.shaderF16) {
+        const std::vector<float> input = testField(len);
+        PooledBuffer inputBuffer = acquireBuffer(context, input.data(), sizeof(float) * input.size());
+        PooledBuffer spectrumBuffer = acquireBuffer(context, nullptr, fieldBytes(FieldStorage::F16, len));
+        PooledBuffer roundTripBuffer = acquireBuffer(context, nullptr, sizeof(float) * input.size());
+        fft(context, spectrumBuffer, inputBuffer, len, plane.rows, plane.cols, 0, false, FFTNorm::Ortho, FieldStorage::F32, FieldStorage::F16);
+        fft(context, roundTripBuffer, spectrumBuffer, len, plane.rows, plane.cols, 1, false, FFTNorm::Ortho, FieldStorage::F16, FieldStorage::F32);
+        report("f16 round trip" + shapeName, relativeError(readBack(context, 2 * len, roundTripBuffer), input), f16Tolerance);
+    } else {
+        std::cerr << "fft check f16 round trip: adapter has no shader-f16, skipped" << std::endl;
+    }
+
+    return passed;
+}
+
 int main(int argc, char* argv[]) {
-    if (argc != 4) {
-        std::cerr << "Usage: " << argv[0] << " <D> <H> <W>" << std::endl;
+    bool tune = false;
+    bool f16 = false;
+    bool realFFT = false;
+    bool checkFFT = false;
+    bool badFlag = false;
+    for (int arg = 4; arg < argc; arg++) {
+        const std::string flag = argv[arg];
+        tune = tune || flag == "--tune";
+        f16 = f16 || flag == "--f16";
+        realFFT = realFFT || flag == "--rfft";
+        checkFFT = checkFFT || flag == "--check-fft";
+        badFlag = badFlag || (flag != "--tune" && flag != "--f16" && flag != "--rfft" && flag != "--check-fft");
+    }
+    if (argc < 4 || badFlag) {
+        std::cerr << "Usage: " << argv[0] << " <D> <H> <W> [--tune] [--f16] [--rfft] [--check-fft]" << std::endl;
         return 1;
     }
 
@@ -19,16 +278,16 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
-    std::vector<std::vector<std::vector<float>>> input_tensor(
-        static_cast<size_t>(D),
-        std::vector<std::vector<float>>(
-            static_cast<size_t>(H),
-            std::vector<float>(static_cast<size_t>(W), 0.0f)
-        )
-    );
+    const Tensor3D input_tensor(static_cast<size_t>(D), static_cast<size_t>(H), static_cast<size_t>(W));
 
     WebGPUContext context;
+    ContextGuard contextGuard(context);
     initWebGPU(context);
+    if (tune) {
+        autotune(context, H, W);
+        saveTuning(context);
+        std::cerr << "Saved tuning for " << tuningKey(context.capabilities) << " to " << tuningFilePath() << std::endl;
+    }
 
     const std::vector<float> res = {0.1f, 0.1f, 0.1f};
     constexpr float na = 0.65f;
@@ -47,5 +306,43 @@ int main(int argc, char* argv[]) {
     const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
     std::cout << duration.count() << std::endl;
 
-    return 0;
+    const PipelineCacheStats stats = getPipelineCacheStats(context);
+    std::cerr << "Pipeline cache: " << stats.size << " compiled, "
+              << stats.hits << " hits, " << stats.misses << " misses" << std::endl;
+    std::cerr << "Queue submits: " << context.stream.submits << " for "
+              << context.stream.recordedCommands << " recorded commands" << std::endl;
+
+    const BufferPoolStats pool = getBufferPoolStats(context);
+    std::cerr << "Buffer pool: " << pool.allocations << " allocations, " << pool.reuses << " reuses ("
+              << pool.reuseRate * 100.0 << "%), peak " << pool.peakBytes / (1024.0 * 1024.0) << " MiB, "
+              << pool.liveBuffers << " live" << std::endl;
+
+    // Row and column passes of the field FFT, which should now cost about the same
+    constexpr int fft_runs = 20;
+    const size_t field_len = static_cast<size_t>(H) * static_cast<size_t>(W);
+    PooledBuffer fftInput = acquireBuffer(context, nullptr, sizeof(float) * 2 * field_len);
+    PooledBuffer fftOutput = acquireBuffer(context, nullptr, sizeof(float) * 2 * field_len);
+    FFTPlan& plan = getFFTPlan(context, H, W, 1, false);
+    const double row_ms = timeFFTPass(context, plan, fftOutput, fftInput, FFTPlan::Pass::Rows, fft_runs);
+    const double col_ms = timeFFTPass(context, plan, fftOutput, fftInput, FFTPlan::Pass::Columns, fft_runs);
+    fftInput.reset();
+    fftOutput.reset();
+    std::cerr << "FFT passes (" << H << "x" << W << ", " << fft_runs << " runs): rows " << row_ms
+              << " ms, columns " << col_ms << " ms" << std::endl;
+
+    if (f16) {
+        reportF16Accuracy(context, D, H, W, res, na, n0);
+        for (int grid : {256, 512}) {
+            if (grid != H || grid != W) {
+                reportF16Accuracy(context, std::min(D, 16), grid, grid, res, na, n0);
+            }
+        }
+    }
+
+    if (realFFT) {
+        reportRealFFTAccuracy(context, H, W);
+    }
+
+    const bool fftPassed = !checkFFT || checkFFTAccuracy(context);
+    return fftPassed ? 0 : 1;
 }
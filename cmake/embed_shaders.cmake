@@ -0,0 +1,37 @@
+# Generates a C++ source embedding every WGSL shader under SHADER_ROOT/src.
+# Run in script mode: cmake -DSHADER_ROOT=<repo> -DOUTPUT=<file.cpp> -P embed_shaders.cmake
+# Shader ids are paths relative to SHADER_ROOT, e.g. "src/common/fft/fft_butterfly.wgsl".
+
+file(GLOB_RECURSE SHADER_FILES RELATIVE ${SHADER_ROOT} ${SHADER_ROOT}/src/*.wgsl)
+list(SORT SHADER_FILES)
+
+set(GENERATED "// Generated by cmake/embed_shaders.cmake. Do not edit.\n")
+string(APPEND GENERATED "#include \"common/shader_registry.h\"\n\n")
+string(APPEND GENERATED "#include <utility>\n\n")
+string(APPEND GENERATED "namespace {\n\n")
+string(APPEND GENERATED "constexpr std::pair<std::string_view, std::string_view> embeddedShaders[] = {\n")
+
+foreach(SHADER ${SHADER_FILES})
+    file(READ ${SHADER_ROOT}/${SHADER} SOURCE)
+    string(FIND "${SOURCE}" ")wgsl\"" DELIMITER_POS)
+    if (NOT DELIMITER_POS EQUAL -1)
+        message(FATAL_ERROR "${SHADER} contains the raw string delimiter )wgsl\"")
+    endif()
+    string(APPEND GENERATED "    {\"${SHADER}\", R\"wgsl(${SOURCE})wgsl\"},\n")
+endforeach()
+
+string(APPEND GENERATED "};\n\n")
+string(APPEND GENERATED "} // namespace\n\n")
+string(APPEND GENERATED "std::string_view findEmbeddedShader(std::string_view id) {\n")
+string(APPEND GENERATED "    for (const auto& [name, source] : embeddedShaders) {\n")
+string(APPEND GENERATED "        if (name == id) {\n")
+string(APPEND GENERATED "            return source;\n")
+string(APPEND GENERATED "        }\n")
+string(APPEND GENERATED "    }\n")
+string(APPEND GENERATED "    return {};\n")
+string(APPEND GENERATED "}\n")
+
+# Only touch the output when it changes so optics_core is not rebuilt needlessly
+file(WRITE ${OUTPUT}.tmp "${GENERATED}")
+execute_process(COMMAND ${CMAKE_COMMAND} -E copy_if_different ${OUTPUT}.tmp ${OUTPUT})
+file(REMOVE ${OUTPUT}.tmp)
@@ -4,7 +4,7 @@ namespace born {
 
 namespace {
 
-wgpu::Buffer create_incident_field(
+PooledBuffer create_incident_field(
     WebGPUContext& context,
     const std::vector<int>& shape,
     const std::vector<float>& res,
@@ -23,8 +23,8 @@ wgpu::Buffer create_incident_field(
 
     incident[idx * 2] = static_cast<float>(buffer_len);
 
-    return createBuffer(
-        context.device,
+    return acquireBuffer(
+        context,
         incident.data(),
         sizeof(float) * incident.size(),
         WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
@@ -33,161 +33,139 @@ wgpu::Buffer create_incident_field(
 
 } // namespace
 
-std::vector<std::vector<std::vector<float>>> forward(
+Tensor3D forward(
     WebGPUContext& context,
-    std::vector<std::vector<std::vector<float>>> n,
-    std::vector<float> res,
+    const Tensor3D& n,
+    const std::vector<float>& res,
     float na,
-    std::vector<std::vector<float>> angles,
+    const std::vector<std::vector<float>>& angles,
     float n0,
     int outputType
 ) {
-    const std::vector<int> shape = {int(n[0].size()), int(n[0][0].size())};
+    const std::vector<int> shape = {int(n.rows()), int(n.cols())};
     const size_t buffer_len = static_cast<size_t>(shape[0]) * static_cast<size_t>(shape[1]);
-    std::vector<std::vector<std::vector<float>>> result;
-
-    for (const std::vector<float>& c_ba : angles) {
-        wgpu::Buffer fieldBuffer = create_incident_field(context, shape, res, c_ba);
-
-        for (size_t z = 0; z < n.size(); ++z) {
-            std::vector<float> complexSlice(buffer_len * 2, 0.0f);
-            size_t offset = 0;
-            for (const auto& row : n[z]) {
-                for (float value : row) {
-                    complexSlice[offset++] = value;
-                    complexSlice[offset++] = 0.0f;
-                }
-            }
+    const size_t spectrum_len = static_cast<size_t>(shape[0]) * static_cast<size_t>(shape[1] / 2 + 1);
 
-            wgpu::Buffer sliceBuffer = createBuffer(
-                context.device,
-                complexSlice.data(),
-                sizeof(float) * complexSlice.size(),
-                WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
-            );
+    // One slice per angle, or a (real, imag) pair for complex output; filled while later angles are encoded
+    Tensor3D result(outputType == 2 ? angles.size() * 2 : angles.size(), shape[0], shape[1]);
 
-            wgpu::Buffer potentialSpatialBuffer = createBuffer(
-                context.device,
-                nullptr,
-                sizeof(float) * buffer_len * 2,
-                WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
-            );
-            scatter_potential(context, potentialSpatialBuffer, sliceBuffer, buffer_len, res[0], n0);
-            sliceBuffer.release();
+    // Uploaded once and shared by every angle
+    GpuVolume volume = uploadVolume(context, n);
+
+    for (size_t angle = 0; angle < angles.size(); ++angle) {
+        const std::vector<float>& c_ba = angles[angle];
+        GpuStreamScope stream(context);
+        PooledBuffer fieldBuffer = create_incident_field(context, shape, res, c_ba);
 
-            wgpu::Buffer potentialFourierBuffer = createBuffer(
-                context.device,
+        for (size_t z = 0; z < n.depth(); ++z) {
+            // A real RI gives a real potential, whose half spectrum is all the propagation term reads
+            const bool realPotential = !volume.hasImag();
+            PooledBuffer potentialSpatialBuffer = acquireBuffer(
+                context,
                 nullptr,
-                sizeof(float) * buffer_len * 2,
+                sizeof(float) * buffer_len * (realPotential ? 1 : 2),
                 WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
             );
-            fft(
+            PooledBuffer potentialFourierBuffer = acquireBuffer(
                 context,
-                potentialFourierBuffer,
-                potentialSpatialBuffer,
-                buffer_len,
-                shape[0],
-                shape[1],
-                0
+                nullptr,
+                sizeof(float) * 2 * (realPotential ? spectrum_len : buffer_len),
+                WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
             );
-            potentialSpatialBuffer.release();
+            if (realPotential) {
+                scatter_potential_real(context, potentialSpatialBuffer, volume.slice(z), buffer_len, res[0], n0);
+                rfft(context, potentialFourierBuffer, potentialSpatialBuffer, buffer_len, shape[0], shape[1]);
+            } else {
+                scatter_potential(context, potentialSpatialBuffer, volume.slice(z), volume.imagSlice(z), buffer_len, res[0], n0);
+                fft(
+                    context,
+                    potentialFourierBuffer,
+                    potentialSpatialBuffer,
+                    buffer_len,
+                    shape[0],
+                    shape[1],
+                    0
+                );
+            }
+            potentialSpatialBuffer.reset();
 
-            wgpu::Buffer termBuffer = createBuffer(
-                context.device,
+            PooledBuffer termBuffer = acquireBuffer(
+                context,
                 nullptr,
                 sizeof(float) * buffer_len * 2,
                 WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
             );
-            const float depth = float(n.size()) / 2.0f - float(z);
-            propagation_term(context, termBuffer, potentialFourierBuffer, buffer_len, shape, res, c_ba, depth);
-            potentialFourierBuffer.release();
+            const float depth = float(n.depth()) / 2.0f - float(z);
+            propagation_term(context, termBuffer, potentialFourierBuffer, buffer_len, shape, res, c_ba, depth, realPotential);
+            potentialFourierBuffer.reset();
 
-            wgpu::Buffer nextFieldBuffer = createBuffer(
-                context.device,
+            PooledBuffer nextFieldBuffer = acquireBuffer(
+                context,
                 nullptr,
                 sizeof(float) * buffer_len * 2,
                 WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
             );
             complex_add(context, nextFieldBuffer, fieldBuffer, termBuffer, buffer_len);
-            fieldBuffer.release();
-            termBuffer.release();
-            fieldBuffer = nextFieldBuffer;
+            termBuffer.reset();
+            fieldBuffer = std::move(nextFieldBuffer);
+            flushStream(context);
         }
 
-        wgpu::Buffer pupilBuffer = createBuffer(
-            context.device,
+        PooledBuffer pupilBuffer = acquireBuffer(
+            context,
             nullptr,
             sizeof(int) * buffer_len,
             WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
         );
         binary_pupil(context, pupilBuffer, shape, na, res);
 
-        wgpu::Buffer filteredFieldBuffer = createBuffer(
-            context.device,
+        PooledBuffer filteredFieldBuffer = acquireBuffer(
+            context,
             nullptr,
             sizeof(float) * buffer_len * 2,
             WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
         );
         mult(context, filteredFieldBuffer, fieldBuffer, pupilBuffer, buffer_len);
-        fieldBuffer.release();
-        pupilBuffer.release();
+        fieldBuffer.reset();
+        pupilBuffer.reset();
 
-        wgpu::Buffer complexSlice = createBuffer(
-            context.device,
+        PooledBuffer complexSlice = acquireBuffer(
+            context,
             nullptr,
             sizeof(float) * buffer_len * 2,
             WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
         );
         fft(context, complexSlice, filteredFieldBuffer, buffer_len, shape[0], shape[1], 1);
-        filteredFieldBuffer.release();
+        filteredFieldBuffer.reset();
 
-        if (outputType == 2) {
-            std::vector<float> complexData = readBack(
-                context.device,
-                context.queue,
-                buffer_len * 2,
-                complexSlice
-            );
-            complexSlice.release();
-
-            std::vector<std::vector<float>> realSlice(shape[0], std::vector<float>(shape[1], 0.0f));
-            std::vector<std::vector<float>> imagSlice(shape[0], std::vector<float>(shape[1], 0.0f));
-            for (int i = 0; i < shape[0]; ++i) {
-                for (int j = 0; j < shape[1]; ++j) {
-                    const int idx = i * shape[1] + j;
-                    realSlice[i][j] = complexData[idx * 2];
-                    imagSlice[i][j] = complexData[idx * 2 + 1];
-                }
+        auto storeReadback = [&result, angle, outputType](const void* data, size_t) {
+            if (outputType == 2) {
+                storeComplexSlice(result, angle * 2, static_cast<const float*>(data));
+            } else {
+                storeSlice(result, angle, static_cast<const float*>(data));
             }
-            result.push_back(realSlice);
-            result.push_back(imagSlice);
+        };
+
+        if (outputType == 2) {
+            readBackAsync(context, complexSlice, sizeof(float) * buffer_len * 2, storeReadback);
         } else {
-            wgpu::Buffer sliceBuffer = createBuffer(
-                context.device,
+            PooledBuffer sliceBuffer = acquireBuffer(
+                context,
                 nullptr,
                 sizeof(float) * buffer_len,
                 WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
             );
             intense(context, sliceBuffer, complexSlice, buffer_len, outputType == 1);
-            std::vector<float> slice = readBack(
-                context.device,
-                context.queue,
-                buffer_len,
-                sliceBuffer
-            );
-            complexSlice.release();
-            sliceBuffer.release();
-
-            std::vector<std::vector<float>> reshapedSlice(shape[0], std::vector<float>(shape[1], 0.0f));
-            for (int i = 0; i < shape[0]; ++i) {
-                for (int j = 0; j < shape[1]; ++j) {
-                    reshapedSlice[i][j] = slice[size_t(i) * size_t(shape[1]) + size_t(j)];
-                }
-            }
-            result.push_back(reshapedSlice);
+            readBackAsync(context, sliceBuffer, sizeof(float) * buffer_len, storeReadback);
         }
+
+        // Collect finished readbacks so their staging slots return to the ring
+        pollReadbacks(context);
     }
 
+    waitForReadbacks(context);
+    trimBufferPool(context);
+
     return result;
 }
 
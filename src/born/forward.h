@@ -6,6 +6,7 @@
 #include "../common/fft/fft.h"
 #include "../common/intensity/intensity.h"
 #include "../common/mult/mult.h"
+#include "../common/gpu_volume.h"
 #include "../common/webgpu_utils.h"
 #include "propagation_term/propagation_term.h"
 #include "scatter_potential/scatter_potential.h"
@@ -16,12 +17,12 @@
 
 namespace born {
 
-std::vector<std::vector<std::vector<float>>> forward(
+Tensor3D forward(
     WebGPUContext& context,
-    std::vector<std::vector<std::vector<float>>> n,
-    std::vector<float> res,
+    const Tensor3D& n,
+    const std::vector<float>& res,
     float na,
-    std::vector<std::vector<float>> angles,
+    const std::vector<std::vector<float>>& angles,
     float n0,
     int outputType
 );
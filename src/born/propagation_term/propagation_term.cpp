@@ -10,8 +10,6 @@ struct Params {
     float angle[4];   // c_ba[0], c_ba[1], 0, 0
 };
 
-static size_t buffer_len;
-
 static wgpu::BindGroupLayout createBindGroupLayout(wgpu::Device& device) {
     wgpu::BindGroupLayoutEntry inputBufferLayout = {};
     inputBufferLayout.binding = 0;
@@ -45,14 +43,16 @@ static wgpu::BindGroup createBindGroup(
     wgpu::Device& device,
     wgpu::BindGroupLayout bindGroupLayout,
     wgpu::Buffer inputBuffer,
+    uint64_t input_size,
     wgpu::Buffer outputBuffer,
-    wgpu::Buffer uniformBuffer
+    wgpu::Buffer uniformBuffer,
+    size_t buffer_len
 ) {
     wgpu::BindGroupEntry inputEntry = {};
     inputEntry.binding = 0;
     inputEntry.buffer = inputBuffer;
     inputEntry.offset = 0;
-    inputEntry.size = sizeof(float) * buffer_len * 2;
+    inputEntry.size = input_size;
 
     wgpu::BindGroupEntry outputEntry = {};
     outputEntry.binding = 1;
@@ -84,9 +84,10 @@ void propagation_term(
     std::vector<int> shape,
     std::vector<float> res,
     std::vector<float> c_ba,
-    float depth
+    float depth,
+    bool halfSpectrum
 ) {
-    buffer_len = bufferlen;
+    size_t buffer_len = bufferlen;
 
     const float shift_y = std::round(c_ba[0] * res[1] * float(shape[0]));
     const float shift_x = std::round(c_ba[1] * res[2] * float(shape[1]));
@@ -96,52 +97,46 @@ void propagation_term(
         {c_ba[0], c_ba[1], 0.0f, 0.0f},
     };
 
+    const size_t input_len = halfSpectrum ? size_t(shape[0]) * size_t(shape[1] / 2 + 1) : buffer_len;
+
     wgpu::Device device = context.device;
-    wgpu::Queue queue = context.queue;
 
-    WorkgroupLimits limits = getWorkgroupLimits(device);
-    std::string shaderCode = readShaderFile(
+    LaunchConfig launch = linearLaunch(context, buffer_len);
+    CachedPipeline cached = getComputePipeline(
+        context,
         "src/born/propagation_term/propagation_term.wgsl",
-        limits.maxWorkgroupSizeX
+        createBindGroupLayout,
+        launch.workgroupSizeX,
+        1,
+        1,
+        {{"HALF_SPECTRUM", halfSpectrum ? "true" : "false"}}
     );
-    wgpu::ShaderModule shaderModule = createShaderModule(device, shaderCode);
-    wgpu::Buffer uniformBuffer = createBuffer(
-        device,
+    PooledBuffer uniformBuffer = acquireBuffer(
+        context,
         &params,
         sizeof(Params),
         wgpu::BufferUsage::Uniform
     );
 
-    wgpu::BindGroupLayout bindGroupLayout = createBindGroupLayout(device);
+    wgpu::BindGroupLayout bindGroupLayout = cached.bindGroupLayout;
     wgpu::BindGroup bindGroup = createBindGroup(
         device,
         bindGroupLayout,
         inputBuffer,
+        sizeof(float) * 2 * input_len,
         outputBuffer,
-        uniformBuffer
+        uniformBuffer,
+        buffer_len
     );
 
-    wgpu::ComputePipeline computePipeline = createComputePipeline(
-        device,
-        shaderModule,
-        bindGroupLayout
-    );
+    wgpu::ComputePipeline computePipeline = cached.pipeline;
 
-    uint32_t workgroupsX = std::ceil(double(buffer_len) / limits.maxWorkgroupSizeX);
-    wgpu::CommandBuffer commandBuffer = createComputeCommandBuffer(
-        device,
+    dispatchCompute(
+        context,
         computePipeline,
         bindGroup,
-        workgroupsX
+        launch
     );
-    queue.submit(1, &commandBuffer);
-
-    commandBuffer.release();
-    computePipeline.release();
-    bindGroup.release();
-    bindGroupLayout.release();
-    shaderModule.release();
-    uniformBuffer.release();
 }
 
 } // namespace born
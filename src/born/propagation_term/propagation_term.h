@@ -5,6 +5,7 @@
 
 namespace born {
 
+// halfSpectrum reads the input as the rows x (cols / 2 + 1) rfft of a real potential
 void propagation_term(
     WebGPUContext& context,
     wgpu::Buffer& outputBuffer,
@@ -13,7 +14,8 @@ void propagation_term(
     std::vector<int> shape,
     std::vector<float> res,
     std::vector<float> c_ba,
-    float depth
+    float depth,
+    bool halfSpectrum = false
 );
 
 } // namespace born
@@ -4,23 +4,38 @@ struct Params {
     angle: vec4<f32>,
 }
 
-@group(0) @binding(0) var<storage, read> input_slice: array<vec2<f32>>;
+@group(0) @binding(0) var<storage, read> input_slice: array<vec2<f32>>; // full spectrum, or the rfft half spectrum
 @group(0) @binding(1) var<storage, read_write> output_term: array<vec2<f32>>;
 @group(0) @binding(2) var<uniform> params: Params;
 
 const eps: f32 = 1e-8;
+const HALF_SPECTRUM: bool = {{HALF_SPECTRUM}};
 
 fn modulus(x: i32, y: i32) -> i32 {
     return ((x % y) + y) % y;
 }
 
+// Spectrum entry (y, x). A real potential only stores the x <= width / 2 half;
+// the rest follows from V[-y, -x] = conj(V[y, x]).
+fn spectrum_at(y: i32, x: i32, height: i32, width: i32) -> vec2<f32> {
+    if (!HALF_SPECTRUM) {
+        return input_slice[y * width + x];
+    }
+    let half_width = width / 2 + 1;
+    if (x < half_width) {
+        return input_slice[y * half_width + x];
+    }
+    let mirrored = input_slice[modulus(-y, height) * half_width + width - x];
+    return vec2<f32>(mirrored.x, -mirrored.y);
+}
+
 fn near_0(index: i32, size: i32) -> f32 {
     return fract(f32(index) / f32(size) + 0.5) - 0.5;
 }
 
 @compute @workgroup_size({{WORKGROUP_SIZE}})
-fn main(@builtin(global_invocation_id) global_id: vec3<u32>) {
-    let idx = global_id.x;
+fn main(@builtin(global_invocation_id) global_id: vec3<u32>, @builtin(num_workgroups) num_groups: vec3<u32>) {
+    let idx = global_id.x + global_id.y * num_groups.x * {{WORKGROUP_SIZE_X}}u;
     if (idx >= arrayLength(&output_term)) {
         return;
     }
@@ -35,7 +50,6 @@ fn main(@builtin(global_invocation_id) global_id: vec3<u32>) {
 
     let src_y = modulus(y - shift_y, height);
     let src_x = modulus(x - shift_x, width);
-    let src_idx = src_y * width + src_x;
 
     let res_z = params.physics.x;
     let res_y = params.physics.y;
@@ -57,7 +71,7 @@ fn main(@builtin(global_invocation_id) global_id: vec3<u32>) {
         cos(phase) / (2.0 * kz)
     );
 
-    let value = input_slice[src_idx];
+    let value = spectrum_at(src_y, src_x, height, width);
     output_term[idx] = vec2<f32>(
         value.x * factor.x - value.y * factor.y,
         value.x * factor.y + value.y * factor.x
@@ -11,9 +11,7 @@ struct Params {
     float pad1;
 };
 
-static size_t buffer_len;
-
-static wgpu::BindGroupLayout createBindGroupLayout(wgpu::Device& device) {
+static wgpu::BindGroupLayout buildBindGroupLayout(wgpu::Device& device, bool withImag) {
     wgpu::BindGroupLayoutEntry inputBufferLayout = {};
     inputBufferLayout.binding = 0;
     inputBufferLayout.visibility = wgpu::ShaderStage::Compute;
@@ -29,37 +27,54 @@ static wgpu::BindGroupLayout createBindGroupLayout(wgpu::Device& device) {
     uniformBufferLayout.visibility = wgpu::ShaderStage::Compute;
     uniformBufferLayout.buffer.type = wgpu::BufferBindingType::Uniform;
 
+    wgpu::BindGroupLayoutEntry imagBufferLayout = {};
+    imagBufferLayout.binding = 3;
+    imagBufferLayout.visibility = wgpu::ShaderStage::Compute;
+    imagBufferLayout.buffer.type = wgpu::BufferBindingType::ReadOnlyStorage;
+
     wgpu::BindGroupLayoutEntry entries[] = {
         inputBufferLayout,
         outputBufferLayout,
-        uniformBufferLayout
+        uniformBufferLayout,
+        imagBufferLayout
     };
 
     wgpu::BindGroupLayoutDescriptor layoutDesc = {};
-    layoutDesc.entryCount = 3;
+    layoutDesc.entryCount = withImag ? 4 : 3;
     layoutDesc.entries = entries;
 
     return device.createBindGroupLayout(layoutDesc);
 }
 
+static wgpu::BindGroupLayout createBindGroupLayout(wgpu::Device& device) {
+    return buildBindGroupLayout(device, false);
+}
+
+static wgpu::BindGroupLayout createImagBindGroupLayout(wgpu::Device& device) {
+    return buildBindGroupLayout(device, true);
+}
+
 static wgpu::BindGroup createBindGroup(
     wgpu::Device& device,
     wgpu::BindGroupLayout bindGroupLayout,
-    wgpu::Buffer inputBuffer,
+    const BufferView& inputBuffer,
+    const BufferView& imagBuffer,
     wgpu::Buffer outputBuffer,
-    wgpu::Buffer uniformBuffer
+    uint64_t output_size,
+    wgpu::Buffer uniformBuffer,
+    size_t buffer_len
 ) {
     wgpu::BindGroupEntry inputEntry = {};
     inputEntry.binding = 0;
-    inputEntry.buffer = inputBuffer;
-    inputEntry.offset = 0;
-    inputEntry.size = sizeof(float) * buffer_len * 2;
+    inputEntry.buffer = inputBuffer.buffer;
+    inputEntry.offset = inputBuffer.offset;
+    inputEntry.size = sizeof(float) * buffer_len;
 
     wgpu::BindGroupEntry outputEntry = {};
     outputEntry.binding = 1;
     outputEntry.buffer = outputBuffer;
     outputEntry.offset = 0;
-    outputEntry.size = sizeof(float) * buffer_len * 2;
+    outputEntry.size = output_size;
 
     wgpu::BindGroupEntry uniformEntry = {};
     uniformEntry.binding = 2;
@@ -67,11 +82,17 @@ static wgpu::BindGroup createBindGroup(
     uniformEntry.offset = 0;
     uniformEntry.size = sizeof(Params);
 
-    wgpu::BindGroupEntry entries[] = {inputEntry, outputEntry, uniformEntry};
+    wgpu::BindGroupEntry imagEntry = {};
+    imagEntry.binding = 3;
+    imagEntry.buffer = imagBuffer.buffer;
+    imagEntry.offset = imagBuffer.offset;
+    imagEntry.size = sizeof(float) * buffer_len;
+
+    wgpu::BindGroupEntry entries[] = {inputEntry, outputEntry, uniformEntry, imagEntry};
 
     wgpu::BindGroupDescriptor bindGroupDesc = {};
     bindGroupDesc.layout = bindGroupLayout;
-    bindGroupDesc.entryCount = 3;
+    bindGroupDesc.entryCount = imagBuffer.buffer ? 4 : 3;
     bindGroupDesc.entries = entries;
 
     return device.createBindGroup(bindGroupDesc);
@@ -80,60 +101,100 @@ static wgpu::BindGroup createBindGroup(
 void scatter_potential(
     WebGPUContext& context,
     wgpu::Buffer& outputBuffer,
-    wgpu::Buffer& inputBuffer,
+    const BufferView& inputBuffer,
+    const BufferView& imagBuffer,
     size_t bufferlen,
     float res_z,
     float n0
 ) {
-    buffer_len = bufferlen;
+    size_t buffer_len = bufferlen;
     Params params = {res_z, n0, 0.0f, 0.0f};
 
     wgpu::Device device = context.device;
-    wgpu::Queue queue = context.queue;
 
-    WorkgroupLimits limits = getWorkgroupLimits(device);
-    std::string shaderCode = readShaderFile(
-        "src/born/scatter_potential/scatter_potential.wgsl",
-        limits.maxWorkgroupSizeX
+    LaunchConfig launch = linearLaunch(context, buffer_len);
+    const char* shaderFile = imagBuffer.buffer
+        ? "src/born/scatter_potential/scatter_potential_imag.wgsl"
+        : "src/born/scatter_potential/scatter_potential.wgsl";
+    CachedPipeline cached = getComputePipeline(
+        context,
+        shaderFile,
+        imagBuffer.buffer ? createImagBindGroupLayout : createBindGroupLayout,
+        launch.workgroupSizeX
     );
-    wgpu::ShaderModule shaderModule = createShaderModule(device, shaderCode);
-    wgpu::Buffer uniformBuffer = createBuffer(
-        device,
+    PooledBuffer uniformBuffer = acquireBuffer(
+        context,
         &params,
         sizeof(Params),
         wgpu::BufferUsage::Uniform
     );
 
-    wgpu::BindGroupLayout bindGroupLayout = createBindGroupLayout(device);
+    wgpu::BindGroupLayout bindGroupLayout = cached.bindGroupLayout;
     wgpu::BindGroup bindGroup = createBindGroup(
         device,
         bindGroupLayout,
         inputBuffer,
+        imagBuffer,
         outputBuffer,
-        uniformBuffer
+        sizeof(float) * buffer_len * 2,
+        uniformBuffer,
+        buffer_len
     );
 
-    wgpu::ComputePipeline computePipeline = createComputePipeline(
-        device,
-        shaderModule,
-        bindGroupLayout
+    wgpu::ComputePipeline computePipeline = cached.pipeline;
+
+    dispatchCompute(
+        context,
+        computePipeline,
+        bindGroup,
+        launch
     );
+}
 
-    uint32_t workgroupsX = std::ceil(double(buffer_len) / limits.maxWorkgroupSizeX);
-    wgpu::CommandBuffer commandBuffer = createComputeCommandBuffer(
+void scatter_potential_real(
+    WebGPUContext& context,
+    wgpu::Buffer& outputBuffer,
+    const BufferView& inputBuffer,
+    size_t bufferlen,
+    float res_z,
+    float n0
+) {
+    size_t buffer_len = bufferlen;
+    Params params = {res_z, n0, 0.0f, 0.0f};
+
+    wgpu::Device device = context.device;
+
+    LaunchConfig launch = linearLaunch(context, buffer_len);
+    CachedPipeline cached = getComputePipeline(
+        context,
+        "src/born/scatter_potential/scatter_potential_real.wgsl",
+        createBindGroupLayout,
+        launch.workgroupSizeX
+    );
+    PooledBuffer uniformBuffer = acquireBuffer(
+        context,
+        &params,
+        sizeof(Params),
+        wgpu::BufferUsage::Uniform
+    );
+
+    wgpu::BindGroup bindGroup = createBindGroup(
         device,
-        computePipeline,
+        cached.bindGroupLayout,
+        inputBuffer,
+        BufferView(),
+        outputBuffer,
+        sizeof(float) * buffer_len,
+        uniformBuffer,
+        buffer_len
+    );
+
+    dispatchCompute(
+        context,
+        cached.pipeline,
         bindGroup,
-        workgroupsX
+        launch
     );
-    queue.submit(1, &commandBuffer);
-
-    commandBuffer.release();
-    computePipeline.release();
-    bindGroup.release();
-    bindGroupLayout.release();
-    shaderModule.release();
-    uniformBuffer.release();
 }
 
 } // namespace born
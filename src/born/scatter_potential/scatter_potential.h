@@ -8,7 +8,18 @@ namespace born {
 void scatter_potential(
     WebGPUContext& context,
     wgpu::Buffer& outputBuffer,
-    wgpu::Buffer& inputBuffer,
+    const BufferView& inputBuffer,
+    const BufferView& imagBuffer,
+    size_t bufferlen,
+    float res_z,
+    float n0
+);
+
+// Potential of a real RI slice as bufferlen real floats, for rfft
+void scatter_potential_real(
+    WebGPUContext& context,
+    wgpu::Buffer& outputBuffer,
+    const BufferView& inputBuffer,
     size_t bufferlen,
     float res_z,
     float n0
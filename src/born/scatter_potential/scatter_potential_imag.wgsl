@@ -0,0 +1,30 @@
+struct Params {
+    res_z: f32,
+    n0: f32,
+    pad0: f32,
+    pad1: f32,
+}
+
+@group(0) @binding(0) var<storage, read> input_n: array<f32>;
+@group(0) @binding(1) var<storage, read_write> output_potential: array<vec2<f32>>;
+@group(0) @binding(2) var<uniform> params: Params;
+@group(0) @binding(3) var<storage, read> input_imag: array<f32>;
+
+@compute @workgroup_size({{WORKGROUP_SIZE}})
+fn main(@builtin(global_invocation_id) global_id: vec3<u32>, @builtin(num_workgroups) num_groups: vec3<u32>) {
+    let idx = global_id.x + global_id.y * num_groups.x * {{WORKGROUP_SIZE_X}}u;
+    if (idx >= arrayLength(&output_potential)) {
+        return;
+    }
+
+    let pi = radians(180.0);
+    let factor = pow((2.0 * pi * params.res_z / params.n0), 2.0);
+    let a = input_n[idx];
+    let b = input_imag[idx];
+
+    // delta_n = a + i b, potential = factor * delta_n * (2 n0 + delta_n)
+    let real_part = a * (2.0 * params.n0 + a) - b * b;
+    let imag_part = b * (2.0 * params.n0 + 2.0 * a);
+
+    output_potential[idx] = factor * vec2<f32>(real_part, imag_part);
+}
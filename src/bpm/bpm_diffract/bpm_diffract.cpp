@@ -5,9 +5,6 @@ struct Params {
     float dz;
 };
 
-static size_t buffer_len;
-static size_t res_buffer_len;
-
 // CREATING BIND GROUP AND LAYOUT
 static wgpu::BindGroupLayout createBindGroupLayout(wgpu::Device& device) {
     wgpu::BindGroupLayoutEntry outputBufferLayout = {};
@@ -51,7 +48,10 @@ static wgpu::BindGroup createBindGroup(
     wgpu::Buffer inputBuffer, 
     wgpu::Buffer resBuffer, 
     wgpu::Buffer cgammaBuffer,
-    wgpu::Buffer uniformBuffer
+    wgpu::Buffer uniformBuffer,
+    size_t buffer_len,
+    size_t field_len,
+    size_t res_buffer_len
 ) {
     wgpu::BindGroupEntry outputEntry = {};
     outputEntry.binding = 0;
@@ -75,7 +75,7 @@ static wgpu::BindGroup createBindGroup(
     cgammaEntry.binding = 3;
     cgammaEntry.buffer = cgammaBuffer;
     cgammaEntry.offset = 0;
-    cgammaEntry.size = sizeof(float) * buffer_len;
+    cgammaEntry.size = sizeof(float) * field_len;
 
     wgpu::BindGroupEntry uniformEntry = {};
     uniformEntry.binding = 4;
@@ -102,44 +102,31 @@ void diffract(
     std::optional<std::vector<float>> res, 
     std::optional<float> dz
 ) {
-    buffer_len = bufferlen;
-    res_buffer_len = res.value().size();
+    size_t buffer_len = bufferlen;
+    size_t field_len = size_t(shape[0]) * shape[1];
+    size_t res_buffer_len = res.value().size();
     Params params = {dz.value()};
 
     // INITIALIZING WEBGPU
     wgpu::Device device = context.device;
-    wgpu::Queue queue = context.queue;
 
     // LOADING AND COMPILING SHADER CODE
-    WorkgroupLimits limits = getWorkgroupLimits(device);
-    std::string shaderCode = readShaderFile("src/bpm/bpm_diffract/bpm_diffract.wgsl", limits.maxWorkgroupSizeX);
-    wgpu::ShaderModule shaderModule = createShaderModule(device, shaderCode);
+    LaunchConfig launch = linearLaunch(context, buffer_len);
+    CachedPipeline cached = getComputePipeline(context, "src/bpm/bpm_diffract/bpm_diffract.wgsl", createBindGroupLayout, launch.workgroupSizeX);
 
     // CREATING BUFFERS
-    wgpu::Buffer cgammaBuffer = createBuffer(context.device, nullptr, sizeof(float) * buffer_len, WGPUBufferUsage(wgpu::BufferUsage::Storage));
+    PooledBuffer cgammaBuffer = acquireBuffer(context, nullptr, sizeof(float) * field_len, WGPUBufferUsage(wgpu::BufferUsage::Storage));
     c_gamma(context, cgammaBuffer, res.value(), shape);
-    wgpu::Buffer resBuffer = createBuffer(device, res.value().data(), sizeof(float) * res_buffer_len, wgpu::BufferUsage::Storage);
-    wgpu::Buffer uniformBuffer = createBuffer(device, &params, sizeof(Params), wgpu::BufferUsage::Uniform);
+    PooledBuffer resBuffer = acquireBuffer(context, res.value().data(), sizeof(float) * res_buffer_len, wgpu::BufferUsage::Storage);
+    PooledBuffer uniformBuffer = acquireBuffer(context, &params, sizeof(Params), wgpu::BufferUsage::Uniform);
 
     // CREATING BIND GROUP AND LAYOUT
-    wgpu::BindGroupLayout bindGroupLayout = createBindGroupLayout(device);
-    wgpu::BindGroup bindGroup = createBindGroup(device, bindGroupLayout, outputBuffer, inputBuffer, resBuffer, cgammaBuffer, uniformBuffer);
+    wgpu::BindGroupLayout bindGroupLayout = cached.bindGroupLayout;
+    wgpu::BindGroup bindGroup = createBindGroup(device, bindGroupLayout, outputBuffer, inputBuffer, resBuffer, cgammaBuffer, uniformBuffer, buffer_len, field_len, res_buffer_len);
 
     // CREATING COMPUTE PIPELINE
-    wgpu::ComputePipeline computePipeline = createComputePipeline(device, shaderModule, bindGroupLayout);
+    wgpu::ComputePipeline computePipeline = cached.pipeline;
 
     // ENCODING AND DISPATCHING COMPUTE COMMANDS
-    uint32_t workgroupsX = std::ceil(double(buffer_len)/limits.maxWorkgroupSizeX);
-    wgpu::CommandBuffer commandBuffer = createComputeCommandBuffer(device, computePipeline, bindGroup, workgroupsX);
-    queue.submit(1, &commandBuffer);
-
-    // RELEASE RESOURCES
-    commandBuffer.release();
-    computePipeline.release();
-    bindGroup.release();
-    bindGroupLayout.release();
-    shaderModule.release();
-    cgammaBuffer.release();
-    resBuffer.release();
-    uniformBuffer.release();
+    dispatchCompute(context, computePipeline, bindGroup, launch);
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "../../common/webgpu_utils.h"
 #include "../../common/c_gamma/c_gamma.h"
 
+// bufferlen may cover a batch of shape[0] x shape[1] fields
 void diffract(
     WebGPUContext& context, 
     wgpu::Buffer& outputBuffer, 
@@ -5,14 +5,14 @@
 @group(0) @binding(4) var<uniform> params: f32; // dz
 
 @compute @workgroup_size({{WORKGROUP_SIZE}})
-fn main(@builtin(global_invocation_id) global_id : vec3<u32>) {
-    let idx = global_id.x;
+fn main(@builtin(global_invocation_id) global_id: vec3<u32>, @builtin(num_workgroups) num_groups: vec3<u32>) {
+    let idx = global_id.x + global_id.y * num_groups.x * {{WORKGROUP_SIZE_X}}u;
     if (idx >= arrayLength(&output)) {
         return;
     }
 
     let pi = radians(180.0);
-    let gamma = cgamma[idx];
+    let gamma = cgamma[idx % arrayLength(&cgamma)]; // one field of cgamma serves a whole batch
     let kz = 2.0 * pi * res[0] * gamma;
 
     // Clamp exponent to prevent underflow/overflow
@@ -2,109 +2,121 @@
 
 // BPM FORWARD FUNCTION
 namespace bpm {
-    vector<vector<vector<float>>> forward(
+    // Angles per batch. Bluestein FFTs pad lines to under 4x their length, so a
+    // batch keeps 4x its fields within one storage binding.
+    static size_t angleBatchSize(const WebGPUContext& context, size_t field_bytes, size_t angle_count) {
+        uint64_t limit = std::min<uint64_t>(context.capabilities.maxStorageBufferBindingSize, context.capabilities.maxBufferSize);
+        size_t fit = size_t(limit / (4 * field_bytes));
+        return std::max<size_t>(1, std::min(fit, angle_count));
+    }
+
+    Tensor3D forward(
         WebGPUContext& context, 
-        vector<vector<vector<float>>> n, 
-        vector<float> res, 
+        const Tensor3D& n, 
+        const vector<float>& res, 
         float na, 
-        vector<vector<float>> angles, 
+        const vector<vector<float>>& angles, 
         float n0,
         int outputType
     ) {
-        vector<int> shape = {int(n[0].size()), int(n[0][0].size())};
+        vector<int> shape = {int(n.rows()), int(n.cols())};
+        size_t buffer_len = shape[0] * shape[1];
+
+        // initialize the final result output, angle_size x shape[0] x shape[1]
+        // (2 * angle_size for complex output); filled while later angles are encoded
+        Tensor3D result(outputType == 2 ? angles.size() * 2 : angles.size(), shape[0], shape[1]);
+
+        // upload the RI volume once, shared by every angle
+        GpuVolume volume = uploadVolume(context, n);
+
+        // angles are propagated together as a batch of fields, so every slice's
+        // FFTs and kernels cover the whole batch in single dispatches
+        size_t field_bytes = sizeof(float) * 2 * buffer_len;
+        size_t angle_batch = angleBatchSize(context, field_bytes, angles.size());
 
-        // initialize the final result output
-        vector<vector<vector<float>>> result; // angle_size x shape[0] x shape[1]
+        for(size_t first = 0; first < angles.size(); first += angle_batch) {
+            size_t batch = std::min(angle_batch, angles.size() - first);
+            size_t batch_len = batch * buffer_len;
 
-        for(vector<float> c_ba : angles) {
-            // Configure input field
-            size_t buffer_len = shape[0] * shape[1];
-            wgpu::Buffer fieldBufferF = createBuffer(context.device, nullptr, sizeof(float) * buffer_len * 2, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc));
-            tilt(context, fieldBufferF, c_ba, shape, res);
-            wgpu::Buffer fieldBuffer = createBuffer(context.device, nullptr, sizeof(float) * buffer_len * 2, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc));
-            fft(context, fieldBuffer, fieldBufferF, buffer_len, shape[0], shape[1], 0);
-            fieldBufferF.release();
+            // Record this batch's kernels into one stream
+            GpuStreamScope stream(context);
+
+            // Configure input fields, one tilted plane wave per angle
+            PooledBuffer fieldBufferF = acquireBuffer(context, nullptr, field_bytes * batch, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc));
+            for(size_t b = 0; b < batch; b++) {
+                PooledBuffer tiltBuffer = acquireBuffer(context, nullptr, field_bytes, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc));
+                tilt(context, tiltBuffer, angles[first + b], shape, res);
+                copyBufferToBuffer(context, tiltBuffer, 0, fieldBufferF, b * field_bytes, field_bytes);
+            }
+            PooledBuffer fieldBuffer = acquireBuffer(context, nullptr, field_bytes * batch, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc));
+            fft(context, fieldBuffer, fieldBufferF, batch_len, shape[0], shape[1], 0);
+            fieldBufferF.reset();
             
-            // Propagate the wave through RI distribution
-            for(vector<vector<float>> slice : n) {
-                // propagate the wave 1.0*Δz
-                wgpu::Buffer fieldBuffer2 = createBuffer(context.device, nullptr, sizeof(float) * buffer_len * 2, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc));
-                diffract(context, fieldBuffer2, fieldBuffer, buffer_len, shape, res, 1.0);
-                fieldBuffer.release();
+            // Propagate the waves through RI distribution
+            for(size_t z = 0; z < n.depth(); z++) {
+                // propagate the waves 1.0*Δz
+                PooledBuffer fieldBuffer2 = acquireBuffer(context, nullptr, field_bytes * batch, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc));
+                diffract(context, fieldBuffer2, fieldBuffer, batch_len, shape, res, 1.0);
+                fieldBuffer.reset();
 
                 // compute scattering
-                fieldBuffer = createBuffer(context.device, nullptr, sizeof(float) * buffer_len * 2, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc));
-                vector<float> flatSlice;
-                for (const auto& inner : slice) {
-                    flatSlice.insert(flatSlice.end(), inner.begin(), inner.end());
-                }
-                vector<float> complexSlice;
-                for (float value : flatSlice) {
-                    complexSlice.push_back(value); // real part
-                    complexSlice.push_back(0); // 0 for imag part
-                }
-                wgpu::Buffer sliceBuffer = createBuffer(context.device, complexSlice.data(), sizeof(float) * buffer_len * 2, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc));
-                scatter(context, fieldBuffer, fieldBuffer2, sliceBuffer, buffer_len, shape, res[0], 1.0, n0);
-                fieldBuffer2.release();
-                sliceBuffer.release();
+                fieldBuffer = acquireBuffer(context, nullptr, field_bytes * batch, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc));
+                scatter(context, fieldBuffer, fieldBuffer2, volume.slice(z), volume.imagSlice(z), batch_len, shape, res[0], 1.0, n0);
+                fieldBuffer2.reset();
+
+                // submit once per slice
+                flushStream(context);
             }
 
-            // Propagate the wave back to the focal plane
-            wgpu::Buffer fieldBuffer2 = createBuffer(context.device, nullptr, sizeof(float) * buffer_len * 2, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc));
-            diffract(context, fieldBuffer2, fieldBuffer, buffer_len, shape, res, -1*float(n.size())/2);
-            fieldBuffer.release();
+            // Propagate the waves back to the focal plane
+            PooledBuffer fieldBuffer2 = acquireBuffer(context, nullptr, field_bytes * batch, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc));
+            diffract(context, fieldBuffer2, fieldBuffer, batch_len, shape, res, -1*float(n.depth())/2);
+            fieldBuffer.reset();
             
             // Apply binary pupil
-            wgpu::Buffer pupilBuffer = createBuffer(context.device, nullptr, sizeof(int) * buffer_len, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc));
+            PooledBuffer pupilBuffer = acquireBuffer(context, nullptr, sizeof(int) * buffer_len, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc));
             binary_pupil(context, pupilBuffer, shape, na, res);
-            wgpu::Buffer finalForwardBuffer = createBuffer(context.device, nullptr, sizeof(float) * buffer_len * 2, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc));
-            mult(context, finalForwardBuffer, fieldBuffer2, pupilBuffer, buffer_len);
-            fieldBuffer2.release();
-            pupilBuffer.release();
+            PooledBuffer finalForwardBuffer = acquireBuffer(context, nullptr, field_bytes * batch, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc));
+            mult(context, finalForwardBuffer, fieldBuffer2, pupilBuffer, batch_len, buffer_len);
+            fieldBuffer2.reset();
+            pupilBuffer.reset();
             
-            // Get real space of field
-            wgpu::Buffer complexSlice = createBuffer(context.device, nullptr, sizeof(float) * buffer_len * 2, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc));
-            fft(context, complexSlice, finalForwardBuffer, buffer_len, shape[0], shape[1], 1); // idft
-            finalForwardBuffer.release();
+            // Get real space of fields
+            PooledBuffer complexSlices = acquireBuffer(context, nullptr, field_bytes * batch, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc));
+            fft(context, complexSlices, finalForwardBuffer, batch_len, shape[0], shape[1], 1); // idft
+            finalForwardBuffer.reset();
             
-            // Complex output
-            if (outputType == 2) {
-                vector<float> complexData = readBack(context.device, context.queue, buffer_len * 2, complexSlice);
-                complexSlice.release();
-                
-                // reshape for final result - 2 x H x W (real, imag)
-                vector<vector<float>> realSlice(shape[0], vector<float>(shape[1], 0.0f));
-                vector<vector<float>> imagSlice(shape[0], vector<float>(shape[1], 0.0f));
-                for (int i = 0; i < shape[0]; i++) {
-                    for (int j = 0; j < shape[1]; j++) {
-                        int idx = i * shape[1] + j;
-                        realSlice[i][j] = complexData[idx * 2];     // real part
-                        imagSlice[i][j] = complexData[idx * 2 + 1]; // imag part
+            auto storeReadback = [&result, first, batch, buffer_len, outputType](const void* data, size_t) {
+                const float* fields = static_cast<const float*>(data);
+                for(size_t b = 0; b < batch; b++) {
+                    if (outputType == 2) {
+                        storeComplexSlice(result, (first + b) * 2, fields + b * buffer_len * 2);
+                    } else {
+                        storeSlice(result, first + b, fields + b * buffer_len);
                     }
                 }
-                result.push_back(realSlice);
-                result.push_back(imagSlice);
+            };
+
+            // Complex output
+            if (outputType == 2) {
+                readBackAsync(context, complexSlices, field_bytes * batch, storeReadback);
             } 
             
             // Default output
             else { 
-                wgpu::Buffer sliceBuffer = createBuffer(context.device, nullptr, sizeof(float) * buffer_len, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc));
-                intense(context, sliceBuffer, complexSlice, buffer_len, outputType == 1);
-                vector<float> slice = readBack(context.device, context.queue, buffer_len, sliceBuffer);
-                complexSlice.release();
-                sliceBuffer.release();
-
-                // reshape for final result
-                vector<vector<float>> reshapedSlice(shape[0], vector<float>(shape[1], 0.0f));
-                for (int i = 0; i < shape[0]; i++) {
-                    for (int j = 0; j < shape[1]; j++) {
-                        reshapedSlice[i][j] = slice[i * shape[1] + j];
-                    }
-                }
-                result.push_back(reshapedSlice);
+                PooledBuffer sliceBuffer = acquireBuffer(context, nullptr, sizeof(float) * batch_len, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc));
+                intense(context, sliceBuffer, complexSlices, batch_len, outputType == 1);
+                readBackAsync(context, sliceBuffer, sizeof(float) * batch_len, storeReadback);
             }
+
+            // Collect finished readbacks so their staging slots return to the ring
+            pollReadbacks(context);
         }
 
+        // Collect the queued readbacks
+        waitForReadbacks(context);
+        trimBufferPool(context);
+
         return result;
     }
 }
@@ -9,6 +9,7 @@
 #include "../common/intensity/intensity.h"
 #include "../common/binary_pupil/binary_pupil.h"
 #include "../common/mult/mult.h"
+#include "../common/gpu_volume.h"
 #include <vector>
 #include <iostream>
 #include <algorithm>
@@ -17,12 +18,12 @@ using namespace std;
 
 namespace bpm {
 
-    vector<vector<vector<float>>> forward(
+    Tensor3D forward(
         WebGPUContext& context, 
-        vector<vector<vector<float>>> n, 
-        vector<float> res, 
+        const Tensor3D& n, 
+        const vector<float>& res, 
         float na, 
-        vector<vector<float>> angles, 
+        const vector<vector<float>>& angles, 
         float n0,
         int outputType
     );
@@ -7,10 +7,8 @@ struct Params {
     float n0;
 };
 
-static size_t buffer_len;
-
 // CREATING BIND GROUP AND LAYOUT
-static wgpu::BindGroupLayout createBindGroupLayout(wgpu::Device& device) {
+static wgpu::BindGroupLayout buildBindGroupLayout(wgpu::Device& device, bool withImag) {
     wgpu::BindGroupLayoutEntry inputBufferLayout = {};
     inputBufferLayout.binding = 0;
     inputBufferLayout.visibility = wgpu::ShaderStage::Compute;
@@ -26,27 +24,43 @@ static wgpu::BindGroupLayout createBindGroupLayout(wgpu::Device& device) {
     uniformBufferLayout.visibility = wgpu::ShaderStage::Compute;
     uniformBufferLayout.buffer.type = wgpu::BufferBindingType::Uniform;
 
-    wgpu::BindGroupLayoutEntry entries[] = {inputBufferLayout, scatterBufferLayout, uniformBufferLayout};
+    wgpu::BindGroupLayoutEntry imagBufferLayout = {};
+    imagBufferLayout.binding = 3;
+    imagBufferLayout.visibility = wgpu::ShaderStage::Compute;
+    imagBufferLayout.buffer.type = wgpu::BufferBindingType::ReadOnlyStorage;
+
+    wgpu::BindGroupLayoutEntry entries[] = {inputBufferLayout, scatterBufferLayout, uniformBufferLayout, imagBufferLayout};
 
     wgpu::BindGroupLayoutDescriptor layoutDesc = {};
-    layoutDesc.entryCount = 3;
+    layoutDesc.entryCount = withImag ? 4 : 3;
     layoutDesc.entries = entries;
 
     return device.createBindGroupLayout(layoutDesc);
 }
 
+static wgpu::BindGroupLayout createBindGroupLayout(wgpu::Device& device) {
+    return buildBindGroupLayout(device, false);
+}
+
+// LAYOUT WITH THE SEPARATE IMAGINARY (ABSORPTION) CHANNEL AT BINDING 3
+static wgpu::BindGroupLayout createImagBindGroupLayout(wgpu::Device& device) {
+    return buildBindGroupLayout(device, true);
+}
+
 static wgpu::BindGroup createBindGroup(
     wgpu::Device& device, 
     wgpu::BindGroupLayout bindGroupLayout, 
-    wgpu::Buffer inputBuffer,
+    const BufferView& inputBuffer,
+    const BufferView& imagBuffer,
     wgpu::Buffer scatterBuffer,
-    wgpu::Buffer uniformBuffer
+    wgpu::Buffer uniformBuffer,
+    size_t buffer_len
 ) {
     wgpu::BindGroupEntry inputEntry = {};
     inputEntry.binding = 0;
-    inputEntry.buffer = inputBuffer;
-    inputEntry.offset = 0;
-    inputEntry.size = sizeof(float) * buffer_len * 2;
+    inputEntry.buffer = inputBuffer.buffer;
+    inputEntry.offset = inputBuffer.offset;
+    inputEntry.size = sizeof(float) * buffer_len;
 
     wgpu::BindGroupEntry scatterEntry = {};
     scatterEntry.binding = 1;
@@ -60,11 +74,17 @@ static wgpu::BindGroup createBindGroup(
     uniformEntry.offset = 0;
     uniformEntry.size = sizeof(Params);
 
-    wgpu::BindGroupEntry entries[] = {inputEntry, scatterEntry, uniformEntry};
+    wgpu::BindGroupEntry imagEntry = {};
+    imagEntry.binding = 3;
+    imagEntry.buffer = imagBuffer.buffer;
+    imagEntry.offset = imagBuffer.offset;
+    imagEntry.size = sizeof(float) * buffer_len;
+
+    wgpu::BindGroupEntry entries[] = {inputEntry, scatterEntry, uniformEntry, imagEntry};
 
     wgpu::BindGroupDescriptor bindGroupDesc = {};
     bindGroupDesc.layout = bindGroupLayout;
-    bindGroupDesc.entryCount = 3;
+    bindGroupDesc.entryCount = imagBuffer.buffer ? 4 : 3;
     bindGroupDesc.entries = entries;
 
     return device.createBindGroup(bindGroupDesc);
@@ -74,71 +94,62 @@ void scatter(
     WebGPUContext& context, 
     wgpu::Buffer& outputBuffer, 
     wgpu::Buffer& inputBuffer, 
-    wgpu::Buffer& sliceBuffer,
+    const BufferView& sliceBuffer,
+    const BufferView& imagBuffer,
     size_t bufferlen,
     std::vector<int> shape,
     std::optional<float> res_z, 
     std::optional<float> dz, 
     std::optional<float> n0
 ) {
-    buffer_len = bufferlen;
+    size_t buffer_len = bufferlen;
+    size_t field_len = size_t(shape[0]) * shape[1];
     Params params = {res_z.value(), dz.value(), n0.value()};
 
     // INITIALIZING WEBGPU
     wgpu::Device device = context.device;
-    wgpu::Queue queue = context.queue;
 
     // LOADING AND COMPILING SHADER CODE
-    WorkgroupLimits limits = getWorkgroupLimits(device);
-    std::string shaderCode = readShaderFile("src/bpm/scatter/scatter.wgsl", limits.maxWorkgroupSizeX);
-    wgpu::ShaderModule shaderModule = createShaderModule(device, shaderCode);
+    LaunchConfig launch = linearLaunch(context, field_len);
+    const char* shaderFile = imagBuffer.buffer ? "src/bpm/scatter/scatter_imag.wgsl" : "src/bpm/scatter/scatter.wgsl";
+    auto createLayout = imagBuffer.buffer ? createImagBindGroupLayout : createBindGroupLayout;
+    CachedPipeline cached = getComputePipeline(context, shaderFile, createLayout, launch.workgroupSizeX);
 
-    // CREATING BUFFERS
-    wgpu::Buffer scatterBuffer = createBuffer(device, nullptr, sizeof(float) * buffer_len * 2, wgpu::BufferUsage::Storage);
-    wgpu::Buffer uniformBuffer = createBuffer(device, &params, sizeof(Params), wgpu::BufferUsage::Uniform);
+    // CREATING BUFFERS (one scatter field, shared by every member of a batch)
+    PooledBuffer scatterBuffer = acquireBuffer(context, nullptr, sizeof(float) * field_len * 2, wgpu::BufferUsage::Storage);
+    PooledBuffer uniformBuffer = acquireBuffer(context, &params, sizeof(Params), wgpu::BufferUsage::Uniform);
 
     // CREATING BIND GROUP AND LAYOUT
-    wgpu::BindGroupLayout bindGroupLayout = createBindGroupLayout(device);
+    wgpu::BindGroupLayout bindGroupLayout = cached.bindGroupLayout;
     wgpu::BindGroup bindGroup = createBindGroup(
         device, 
         bindGroupLayout, 
         sliceBuffer,
+        imagBuffer,
         scatterBuffer, 
-        uniformBuffer
+        uniformBuffer,
+        field_len
     );
 
     // CREATING COMPUTE PIPELINE
-    wgpu::ComputePipeline computePipeline = createComputePipeline(device, shaderModule, bindGroupLayout);
+    wgpu::ComputePipeline computePipeline = cached.pipeline;
 
     // ENCODING AND DISPATCHING COMPUTE COMMANDS
-    uint32_t workgroupsX = std::ceil(double(buffer_len)/limits.maxWorkgroupSizeX);
-    wgpu::CommandBuffer commandBuffer = createComputeCommandBuffer(device, computePipeline, bindGroup, workgroupsX);
-    queue.submit(1, &commandBuffer);
-
-    // RELEASE RESOURCES
-    commandBuffer.release();
-    computePipeline.release();
-    bindGroup.release();
-    bindGroupLayout.release();
-    shaderModule.release();
-    uniformBuffer.release();
+    dispatchCompute(context, computePipeline, bindGroup, launch);
 
     // ifft(field)
-    wgpu::Buffer ifftBuffer = createBuffer(device, nullptr, sizeof(float) * buffer_len * 2, wgpu::BufferUsage::Storage);
+    PooledBuffer ifftBuffer = acquireBuffer(context, nullptr, sizeof(float) * buffer_len * 2, wgpu::BufferUsage::Storage);
     fft(context, ifftBuffer, inputBuffer, buffer_len, shape[0], shape[1], 1); // idft
     
     // result = ifft(field) * scatter
-    wgpu::Buffer multBuffer = createBuffer(
-        device,
+    PooledBuffer multBuffer = acquireBuffer(
+        context,
         nullptr,
         sizeof(float) * buffer_len * 2,
         WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
     );
-    complex_mult(context, multBuffer, ifftBuffer, scatterBuffer, buffer_len);
-    scatterBuffer.release();
-    ifftBuffer.release();
+    complex_mult(context, multBuffer, ifftBuffer, scatterBuffer, buffer_len, field_len);
 
     // return fft(result)
     fft(context, outputBuffer, multBuffer, buffer_len, shape[0], shape[1], 0);
-    multBuffer.release();
 }
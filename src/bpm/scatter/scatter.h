@@ -10,11 +10,13 @@
 #include "../../common/fft/fft.h"
 #include "../../common/complex_mult/complex_mult.h"
 
+// bufferlen may cover a batch of shape[0] x shape[1] fields sharing one RI slice
 void scatter(
     WebGPUContext& context, 
     wgpu::Buffer& outputBuffer, 
     wgpu::Buffer& inputBuffer,
-    wgpu::Buffer& sliceBuffer,
+    const BufferView& sliceBuffer,
+    const BufferView& imagBuffer,
     size_t bufferlen,
     std::vector<int> shape,
     std::optional<float> res_z = 0.1, 
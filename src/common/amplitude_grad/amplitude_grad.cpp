@@ -7,8 +7,6 @@ struct Params {
     float inv_pixels;
 };
 
-static size_t buffer_len;
-
 // CREATING BIND GROUP AND LAYOUT
 static wgpu::BindGroupLayout createBindGroupLayout(wgpu::Device& device) {
     wgpu::BindGroupLayoutEntry fieldLayout = {};
@@ -52,7 +50,8 @@ static wgpu::BindGroup createBindGroup(
     wgpu::Buffer fieldBuffer,
     wgpu::Buffer measuredBuffer,
     wgpu::Buffer outputBuffer,
-    wgpu::Buffer uniformBuffer
+    wgpu::Buffer uniformBuffer,
+    size_t buffer_len
 ) {
     wgpu::BindGroupEntry fieldEntry = {};
     fieldEntry.binding = 0;
@@ -101,44 +100,37 @@ void amplitude_grad(
     size_t bufferlen,
     float inv_pixels
 ) {
-    buffer_len = bufferlen;
+    size_t buffer_len = bufferlen;
     Params params = {inv_pixels};
 
     wgpu::Device device = context.device;
-    wgpu::Queue queue = context.queue;
 
-    WorkgroupLimits limits = getWorkgroupLimits(device);
-    std::string shaderCode = readShaderFile(
+    LaunchConfig launch = linearLaunch(context, buffer_len);
+    CachedPipeline cached = getComputePipeline(
+        context,
         "src/common/amplitude_grad/amplitude_grad.wgsl",
-        limits.maxWorkgroupSizeX
+        createBindGroupLayout,
+        launch.workgroupSizeX
     );
-    wgpu::ShaderModule shaderModule = createShaderModule(device, shaderCode);
-    wgpu::Buffer uniformBuffer = createBuffer(
-        device,
+    PooledBuffer uniformBuffer = acquireBuffer(
+        context,
         &params,
         sizeof(Params),
         wgpu::BufferUsage::Uniform
     );
 
-    wgpu::BindGroupLayout bindGroupLayout = createBindGroupLayout(device);
+    wgpu::BindGroupLayout bindGroupLayout = cached.bindGroupLayout;
     wgpu::BindGroup bindGroup = createBindGroup(
         device,
         bindGroupLayout,
         fieldBuffer,
         measuredBuffer,
         outputBuffer,
-        uniformBuffer
+        uniformBuffer,
+        buffer_len
     );
 
-    wgpu::ComputePipeline computePipeline = createComputePipeline(device, shaderModule, bindGroupLayout);
-    uint32_t workgroupsX = static_cast<uint32_t>(std::ceil(double(buffer_len) / limits.maxWorkgroupSizeX));
-    wgpu::CommandBuffer commandBuffer = createComputeCommandBuffer(device, computePipeline, bindGroup, workgroupsX);
-    queue.submit(1, &commandBuffer);
-
-    commandBuffer.release();
-    computePipeline.release();
-    bindGroup.release();
-    bindGroupLayout.release();
-    shaderModule.release();
-    uniformBuffer.release();
+    wgpu::ComputePipeline computePipeline = cached.pipeline;
+    dispatchCompute(context, computePipeline, bindGroup, launch);
+
 }
\ No newline at end of file
@@ -5,8 +5,6 @@ struct Params {
     float na;
 };
 
-static size_t buffer_len;
-
 // CREATING BIND GROUP AND LAYOUT
 static wgpu::BindGroupLayout createBindGroupLayout(wgpu::Device& device) {
     wgpu::BindGroupLayoutEntry cgammaBufferLayout = {};
@@ -38,7 +36,8 @@ static wgpu::BindGroup createBindGroup(
     wgpu::BindGroupLayout bindGroupLayout, 
     wgpu::Buffer cgammaBuffer, 
     wgpu::Buffer maskBuffer, 
-    wgpu::Buffer uniformBuffer
+    wgpu::Buffer uniformBuffer,
+    size_t buffer_len
 ) {
     wgpu::BindGroupEntry cgammaEntry = {};
     cgammaEntry.binding = 0;
@@ -75,41 +74,28 @@ void binary_pupil(
     float na,
     std::optional<std::vector<float>> res 
 ) {
-    buffer_len = shape[0] * shape[1];
+    size_t buffer_len = shape[0] * shape[1];
     Params params = {na};
 
     // INITIALIZING WEBGPU
     wgpu::Device device = context.device;
-    wgpu::Queue queue = context.queue;
 
     // LOADING AND COMPILING SHADER CODE
-    WorkgroupLimits limits = getWorkgroupLimits(device);
-    std::string shaderCode = readShaderFile("src/common/binary_pupil/binary_pupil.wgsl", limits.maxWorkgroupSizeX);
-    wgpu::ShaderModule shaderModule = createShaderModule(device, shaderCode);
+    LaunchConfig launch = linearLaunch(context, buffer_len);
+    CachedPipeline cached = getComputePipeline(context, "src/common/binary_pupil/binary_pupil.wgsl", createBindGroupLayout, launch.workgroupSizeX);
 
     // CREATING BUFFERS
-    wgpu::Buffer cgammaBuffer = createBuffer(device, nullptr, sizeof(float) * buffer_len, wgpu::BufferUsage::Storage);
+    PooledBuffer cgammaBuffer = acquireBuffer(context, nullptr, sizeof(float) * buffer_len, wgpu::BufferUsage::Storage);
     c_gamma(context, cgammaBuffer, res.value(), shape);
-    wgpu::Buffer uniformBuffer = createBuffer(device, &params, sizeof(Params), wgpu::BufferUsage::Uniform);
+    PooledBuffer uniformBuffer = acquireBuffer(context, &params, sizeof(Params), wgpu::BufferUsage::Uniform);
 
     // CREATING BIND GROUP AND LAYOUT
-    wgpu::BindGroupLayout bindGroupLayout = createBindGroupLayout(device);
-    wgpu::BindGroup bindGroup = createBindGroup(device, bindGroupLayout, cgammaBuffer, maskBuffer, uniformBuffer);
+    wgpu::BindGroupLayout bindGroupLayout = cached.bindGroupLayout;
+    wgpu::BindGroup bindGroup = createBindGroup(device, bindGroupLayout, cgammaBuffer, maskBuffer, uniformBuffer, buffer_len);
 
     // CREATING COMPUTE PIPELINE
-    wgpu::ComputePipeline computePipeline = createComputePipeline(device, shaderModule, bindGroupLayout);
+    wgpu::ComputePipeline computePipeline = cached.pipeline;
 
     // ENCODING AND DISPATCHING COMPUTE COMMANDS
-    uint32_t workgroupsX = std::ceil(double(buffer_len)/limits.maxWorkgroupSizeX);
-    wgpu::CommandBuffer commandBuffer = createComputeCommandBuffer(device, computePipeline, bindGroup, workgroupsX);
-    queue.submit(1, &commandBuffer);
-
-    // RELEASE RESOURCES
-    commandBuffer.release();
-    computePipeline.release();
-    bindGroup.release();
-    bindGroupLayout.release();
-    shaderModule.release();
-    cgammaBuffer.release();
-    uniformBuffer.release();
+    dispatchCompute(context, computePipeline, bindGroup, launch);
 }
\ No newline at end of file
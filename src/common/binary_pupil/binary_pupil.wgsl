@@ -3,8 +3,8 @@
 @group(0) @binding(2) var<uniform> params : f32;
 
 @compute @workgroup_size({{WORKGROUP_SIZE}})
-fn main(@builtin(global_invocation_id) global_id : vec3<u32>) {
-    let idx = global_id.x;
+fn main(@builtin(global_invocation_id) global_id: vec3<u32>, @builtin(num_workgroups) num_groups: vec3<u32>) {
+    let idx = global_id.x + global_id.y * num_groups.x * {{WORKGROUP_SIZE_X}}u;
     if (idx >= arrayLength(&cgamma)) {
         return;
     }
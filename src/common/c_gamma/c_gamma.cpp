@@ -6,10 +6,6 @@ struct Params {
     std::vector<int> shape;
 };
 
-static size_t output_buffer_len;
-static size_t res_buffer_len;
-static size_t shape_buffer_len;
-
 // CREATING BIND GROUP AND LAYOUT
 static wgpu::BindGroupLayout createBindGroupLayout(wgpu::Device& device) {
     wgpu::BindGroupLayoutEntry shapeBufferLayout = {};
@@ -41,7 +37,10 @@ static wgpu::BindGroup createBindGroup(
     wgpu::BindGroupLayout bindGroupLayout, 
     wgpu::Buffer shapeBuffer, 
     wgpu::Buffer resBuffer, 
-    wgpu::Buffer outputBuffer
+    wgpu::Buffer outputBuffer,
+    size_t output_buffer_len,
+    size_t res_buffer_len,
+    size_t shape_buffer_len
 ) {
     wgpu::BindGroupEntry shapeEntry = {};
     shapeEntry.binding = 0;
@@ -73,41 +72,28 @@ static wgpu::BindGroup createBindGroup(
 
 void c_gamma(WebGPUContext& context, wgpu::Buffer& outputBuffer, std::vector<float> res, std::vector<int> shape) {
     // Calculate the total number of elements in the output buffer
-    output_buffer_len = shape[0] * shape[1];
-    res_buffer_len = res.size();
-    shape_buffer_len = shape.size();
+    size_t output_buffer_len = shape[0] * shape[1];
+    size_t res_buffer_len = res.size();
+    size_t shape_buffer_len = shape.size();
 
     // INITIALIZING WEBGPU
     wgpu::Device device = context.device;
-    wgpu::Queue queue = context.queue;
     
     // LOADING AND COMPILING SHADER CODE
-    WorkgroupLimits limits = getWorkgroupLimits(device);
-    std::string shaderCode = readShaderFile("src/common/c_gamma/c_gamma.wgsl", limits.maxWorkgroupSizeX);
-    wgpu::ShaderModule shaderModule = createShaderModule(device, shaderCode);
+    LaunchConfig launch = linearLaunch(context, output_buffer_len);
+    CachedPipeline cached = getComputePipeline(context, "src/common/c_gamma/c_gamma.wgsl", createBindGroupLayout, launch.workgroupSizeX);
 
     // CREATING BUFFERS
-    wgpu::Buffer resBuffer = createBuffer(device, res.data(), sizeof(float) * res_buffer_len, wgpu::BufferUsage::Storage);
-    wgpu::Buffer shapeBuffer = createBuffer(device, shape.data(), sizeof(int) * shape_buffer_len, wgpu::BufferUsage::Storage);
+    PooledBuffer resBuffer = acquireBuffer(context, res.data(), sizeof(float) * res_buffer_len, wgpu::BufferUsage::Storage);
+    PooledBuffer shapeBuffer = acquireBuffer(context, shape.data(), sizeof(int) * shape_buffer_len, wgpu::BufferUsage::Storage);
 
     // CREATING BIND GROUP AND LAYOUT
-    wgpu::BindGroupLayout bindGroupLayout = createBindGroupLayout(device);
-    wgpu::BindGroup bindGroup = createBindGroup(device, bindGroupLayout, shapeBuffer, resBuffer, outputBuffer);
+    wgpu::BindGroupLayout bindGroupLayout = cached.bindGroupLayout;
+    wgpu::BindGroup bindGroup = createBindGroup(device, bindGroupLayout, shapeBuffer, resBuffer, outputBuffer, output_buffer_len, res_buffer_len, shape_buffer_len);
 
     // CREATING COMPUTE PIPELINE
-    wgpu::ComputePipeline computePipeline = createComputePipeline(device, shaderModule, bindGroupLayout);
+    wgpu::ComputePipeline computePipeline = cached.pipeline;
 
     // ENCODING AND DISPATCHING COMPUTE COMMANDS
-    uint32_t workgroupsX = std::ceil(double(output_buffer_len)/limits.maxWorkgroupSizeX);
-    wgpu::CommandBuffer commandBuffer = createComputeCommandBuffer(device, computePipeline, bindGroup, workgroupsX);
-    queue.submit(1, &commandBuffer);
-
-    // RELEASE RESOURCES
-    commandBuffer.release();
-    computePipeline.release();
-    bindGroup.release();
-    bindGroupLayout.release();
-    shaderModule.release();
-    resBuffer.release();
-    shapeBuffer.release();
+    dispatchCompute(context, computePipeline, bindGroup, launch);
 }
\ No newline at end of file
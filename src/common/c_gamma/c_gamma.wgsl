@@ -13,8 +13,8 @@ fn near_0(index: i32, size: i32) -> f32 {
 }
 
 @compute @workgroup_size({{WORKGROUP_SIZE}})
-fn main(@builtin(global_invocation_id) global_id: vec3<u32>) {
-    let index: i32 = i32(global_id.x); // Use only the x-dimension for indexing
+fn main(@builtin(global_invocation_id) global_id: vec3<u32>, @builtin(num_workgroups) num_groups: vec3<u32>) {
+    let index: i32 = i32(global_id.x + global_id.y * num_groups.x * {{WORKGROUP_SIZE_X}}u);
 
     let size_x: i32 = shape[0];
     let size_y: i32 = shape[1];
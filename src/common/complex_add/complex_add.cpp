@@ -1,8 +1,6 @@
 #include "complex_add.h"
 #include <cmath>
 
-static size_t buffer_len;
-
 // CREATING BIND GROUP AND LAYOUT
 static wgpu::BindGroupLayout createBindGroupLayout(wgpu::Device& device) {
     wgpu::BindGroupLayoutEntry inputBufferLayout1 = {};
@@ -35,7 +33,8 @@ static wgpu::BindGroup createBindGroup(
     wgpu::BindGroupLayout bindGroupLayout,
     wgpu::Buffer inputBuffer1,
     wgpu::Buffer inputBuffer2,
-    wgpu::Buffer outputBuffer
+    wgpu::Buffer outputBuffer,
+    size_t buffer_len
 ) {
     wgpu::BindGroupEntry inputEntry1 = {};
     inputEntry1.binding = 0;
@@ -72,30 +71,19 @@ void complex_add(
     wgpu::Buffer& inputBuffer2,
     size_t bufferlen
 ) {
-    buffer_len = bufferlen;
+    size_t buffer_len = bufferlen;
 
     // INITIALIZING WEBGPU
     wgpu::Device device = context.device;
-    wgpu::Queue queue = context.queue;
 
     // LOADING AND COMPILING SHADER CODE
-    WorkgroupLimits limits = getWorkgroupLimits(device);
-    std::string shaderCode = readShaderFile("src/common/complex_add/complex_add.wgsl", limits.maxWorkgroupSizeX);
-    wgpu::ShaderModule shaderModule = createShaderModule(device, shaderCode);
+    LaunchConfig launch = linearLaunch(context, buffer_len);
+    CachedPipeline cached = getComputePipeline(context, "src/common/complex_add/complex_add.wgsl", createBindGroupLayout, launch.workgroupSizeX);
 
-    wgpu::BindGroupLayout bindGroupLayout = createBindGroupLayout(device);
-    wgpu::BindGroup bindGroup = createBindGroup(device, bindGroupLayout, inputBuffer1, inputBuffer2, outputBuffer);
+    wgpu::BindGroupLayout bindGroupLayout = cached.bindGroupLayout;
+    wgpu::BindGroup bindGroup = createBindGroup(device, bindGroupLayout, inputBuffer1, inputBuffer2, outputBuffer, buffer_len);
 
     // ENCODING AND DISPATCHING COMPUTE COMMANDS
-    wgpu::ComputePipeline computePipeline = createComputePipeline(device, shaderModule, bindGroupLayout);
-    uint32_t workgroupsX = std::ceil(double(buffer_len) / limits.maxWorkgroupSizeX);
-    wgpu::CommandBuffer commandBuffer = createComputeCommandBuffer(device, computePipeline, bindGroup, workgroupsX);
-    queue.submit(1, &commandBuffer);
-
-    // RELEASE RESOURCES
-    commandBuffer.release();
-    computePipeline.release();
-    bindGroup.release();
-    bindGroupLayout.release();
-    shaderModule.release();
+    wgpu::ComputePipeline computePipeline = cached.pipeline;
+    dispatchCompute(context, computePipeline, bindGroup, launch);
 }
@@ -1,7 +1,5 @@
 #include "complex_mult.h"
 
-static size_t buffer_len;
-
 // CREATING BIND GROUP AND LAYOUT
 static wgpu::BindGroupLayout createBindGroupLayout(wgpu::Device& device) {
     wgpu::BindGroupLayoutEntry inputBufferLayout1 = {};
@@ -33,7 +31,9 @@ static wgpu::BindGroup createBindGroup(
     wgpu::BindGroupLayout bindGroupLayout, 
     wgpu::Buffer inputBuffer1, 
     wgpu::Buffer inputBuffer2,
-    wgpu::Buffer outputBuffer
+    wgpu::Buffer outputBuffer,
+    size_t buffer_len,
+    size_t factor_len
 ) {
     wgpu::BindGroupEntry inputEntry1 = {};
     inputEntry1.binding = 0;
@@ -45,7 +45,7 @@ static wgpu::BindGroup createBindGroup(
     inputEntry2.binding = 1;
     inputEntry2.buffer = inputBuffer2;
     inputEntry2.offset = 0;
-    inputEntry2.size = sizeof(float) * buffer_len * 2;
+    inputEntry2.size = sizeof(float) * factor_len * 2;
 
     wgpu::BindGroupEntry outputEntry = {};
     outputEntry.binding = 2;
@@ -68,39 +68,32 @@ void complex_mult(
     wgpu::Buffer& outputBuffer, 
     wgpu::Buffer& inputBuffer1, 
     wgpu::Buffer& inputBuffer2, 
-    size_t bufferlen
+    size_t bufferlen,
+    size_t factorlen
 ) {
-    buffer_len = bufferlen;
+    size_t buffer_len = bufferlen;
+    size_t factor_len = factorlen ? factorlen : bufferlen;
 
     // INITIALIZING WEBGPU
     wgpu::Device device = context.device;
-    wgpu::Queue queue = context.queue;
 
     // shader file for complex multiplication
-    WorkgroupLimits limits = getWorkgroupLimits(device);
-    std::string shaderCode = readShaderFile("src/common/complex_mult/complex_mult.wgsl", limits.maxWorkgroupSizeX);
-    wgpu::ShaderModule shaderModule = createShaderModule(device, shaderCode);
+    LaunchConfig launch = linearLaunch(context, buffer_len);
+    CachedPipeline cached = getComputePipeline(context, "src/common/complex_mult/complex_mult.wgsl", createBindGroupLayout, launch.workgroupSizeX);
 
     // bind group/layout for complex multiplication
-    wgpu::BindGroupLayout bindGroupLayout = createBindGroupLayout(device);
+    wgpu::BindGroupLayout bindGroupLayout = cached.bindGroupLayout;
     wgpu::BindGroup bindGroup = createBindGroup(
         device, 
         bindGroupLayout, 
         inputBuffer1,
         inputBuffer2, 
-        outputBuffer
+        outputBuffer,
+        buffer_len,
+        factor_len
     );
 
     // perform complex multiplication
-    wgpu::ComputePipeline computePipeline = createComputePipeline(device, shaderModule, bindGroupLayout);
-    uint32_t workgroupsX = std::ceil(double(buffer_len)/limits.maxWorkgroupSizeX);
-    wgpu::CommandBuffer commandBuffer = createComputeCommandBuffer(device, computePipeline, bindGroup, workgroupsX);
-    queue.submit(1, &commandBuffer);
-
-    // Clean resources
-    commandBuffer.release();
-    computePipeline.release();
-    shaderModule.release();
-    bindGroup.release();
-    bindGroupLayout.release();
+    wgpu::ComputePipeline computePipeline = cached.pipeline;
+    dispatchCompute(context, computePipeline, bindGroup, launch);
 }
\ No newline at end of file
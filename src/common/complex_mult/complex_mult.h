@@ -7,12 +7,15 @@
 #include <webgpu/webgpu.hpp>
 #include "../webgpu_utils.h"
 
+// inputBuffer2 may hold factorlen elements repeated across inputBuffer1,
+// e.g. one field applied to every member of a batch; 0 means bufferlen
 void complex_mult(
     WebGPUContext& context, 
     wgpu::Buffer& outputBuffer, 
     wgpu::Buffer& inputBuffer1, 
     wgpu::Buffer& inputBuffer2,
-    size_t bufferlen
+    size_t bufferlen,
+    size_t factorlen = 0
 );
 
 #endif 
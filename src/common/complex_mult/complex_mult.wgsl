@@ -3,14 +3,16 @@
 @group(0) @binding(2) var<storage, read_write> out: array<vec2<f32>>;
 
 @compute @workgroup_size({{WORKGROUP_SIZE}})
-fn main(@builtin(global_invocation_id) id: vec3<u32>) {
-    let i = id.x;
+fn main(@builtin(global_invocation_id) id: vec3<u32>, @builtin(num_workgroups) num_groups: vec3<u32>) {
+    let i = id.x + id.y * num_groups.x * {{WORKGROUP_SIZE_X}}u;
     if (i >= arrayLength(&out)) {
         return;
     }
 
+    // u repeats when it is shorter than the output, e.g. one field over a batch
+    let j = i % arrayLength(&u);
     out[i] = vec2<f32>(
-        scatter[i].x * u[i].x - scatter[i].y * u[i].y, // Real part
-        scatter[i].x * u[i].y + scatter[i].y * u[i].x  // Imaginary part
+        scatter[i].x * u[j].x - scatter[i].y * u[j].y, // Real part
+        scatter[i].x * u[j].y + scatter[i].y * u[j].x  // Imaginary part
     );
 }
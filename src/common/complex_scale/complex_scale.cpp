@@ -5,8 +5,6 @@ struct Params {
     float scale;
 };
 
-static size_t buffer_len;
-
 // CREATING BIND GROUP AND LAYOUT
 static wgpu::BindGroupLayout createBindGroupLayout(wgpu::Device& device) {
     wgpu::BindGroupLayoutEntry inputBufferLayout = {};
@@ -39,7 +37,8 @@ static wgpu::BindGroup createBindGroup(
     wgpu::BindGroupLayout bindGroupLayout,
     wgpu::Buffer inputBuffer,
     wgpu::Buffer outputBuffer,
-    wgpu::Buffer uniformBuffer
+    wgpu::Buffer uniformBuffer,
+    size_t buffer_len
 ) {
     wgpu::BindGroupEntry inputEntry = {};
     inputEntry.binding = 0;
@@ -76,33 +75,21 @@ void complex_scale(
     size_t bufferlen,
     float scale
 ) {
-    buffer_len = bufferlen;
+    size_t buffer_len = bufferlen;
     Params params = {scale};
 
     // INITIALIZING WEBGPU
     wgpu::Device device = context.device;
-    wgpu::Queue queue = context.queue;
 
     // LOADING AND COMPILING SHADER CODE
-    WorkgroupLimits limits = getWorkgroupLimits(device);
-    std::string shaderCode = readShaderFile("src/common/complex_scale/complex_scale.wgsl", limits.maxWorkgroupSizeX);
-    wgpu::ShaderModule shaderModule = createShaderModule(device, shaderCode);
-    wgpu::Buffer uniformBuffer = createBuffer(device, &params, sizeof(Params), wgpu::BufferUsage::Uniform);
+    LaunchConfig launch = linearLaunch(context, buffer_len);
+    CachedPipeline cached = getComputePipeline(context, "src/common/complex_scale/complex_scale.wgsl", createBindGroupLayout, launch.workgroupSizeX);
+    PooledBuffer uniformBuffer = acquireBuffer(context, &params, sizeof(Params), wgpu::BufferUsage::Uniform);
 
-    wgpu::BindGroupLayout bindGroupLayout = createBindGroupLayout(device);
-    wgpu::BindGroup bindGroup = createBindGroup(device, bindGroupLayout, inputBuffer, outputBuffer, uniformBuffer);
+    wgpu::BindGroupLayout bindGroupLayout = cached.bindGroupLayout;
+    wgpu::BindGroup bindGroup = createBindGroup(device, bindGroupLayout, inputBuffer, outputBuffer, uniformBuffer, buffer_len);
 
     // ENCODING AND DISPATCHING COMPUTE COMMANDS
-    wgpu::ComputePipeline computePipeline = createComputePipeline(device, shaderModule, bindGroupLayout);
-    uint32_t workgroupsX = std::ceil(double(buffer_len) / limits.maxWorkgroupSizeX);
-    wgpu::CommandBuffer commandBuffer = createComputeCommandBuffer(device, computePipeline, bindGroup, workgroupsX);
-    queue.submit(1, &commandBuffer);
-
-    // RELEASE RESOURCES
-    commandBuffer.release();
-    computePipeline.release();
-    bindGroup.release();
-    bindGroupLayout.release();
-    shaderModule.release();
-    uniformBuffer.release();
+    wgpu::ComputePipeline computePipeline = cached.pipeline;
+    dispatchCompute(context, computePipeline, bindGroup, launch);
 }
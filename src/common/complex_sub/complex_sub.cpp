@@ -1,7 +1,5 @@
 #include "complex_sub.h"
 
-static size_t buffer_len;
-
 // CREATING BIND GROUP AND LAYOUT
 static wgpu::BindGroupLayout createBindGroupLayout(wgpu::Device& device) {
     wgpu::BindGroupLayoutEntry inputBufferLayout1 = {};
@@ -33,13 +31,15 @@ static wgpu::BindGroup createBindGroup(
     wgpu::BindGroupLayout bindGroupLayout, 
     wgpu::Buffer inputBuffer1, 
     wgpu::Buffer inputBuffer2,
-    wgpu::Buffer outputBuffer
+    wgpu::Buffer outputBuffer,
+    size_t buffer_len,
+    FieldStorage storage
 ) {
     wgpu::BindGroupEntry inputEntry1 = {};
     inputEntry1.binding = 0;
     inputEntry1.buffer = inputBuffer1;
     inputEntry1.offset = 0;
-    inputEntry1.size = sizeof(float) * buffer_len * 2;
+    inputEntry1.size = fieldBytes(storage, buffer_len);
 
     wgpu::BindGroupEntry inputEntry2 = {};
     inputEntry2.binding = 1;
@@ -51,7 +51,7 @@ static wgpu::BindGroup createBindGroup(
     outputEntry.binding = 2;
     outputEntry.buffer = outputBuffer;
     outputEntry.offset = 0;
-    outputEntry.size = sizeof(float) * buffer_len * 2;
+    outputEntry.size = fieldBytes(storage, buffer_len);
 
     wgpu::BindGroupEntry entries[] = {inputEntry1, inputEntry2, outputEntry};
 
@@ -68,39 +68,31 @@ void complex_sub(
     wgpu::Buffer& outputBuffer, 
     wgpu::Buffer& inputBuffer1, 
     wgpu::Buffer& inputBuffer2, 
-    size_t bufferlen
+    size_t bufferlen,
+    FieldStorage storage
 ) {
-    buffer_len = bufferlen;
+    size_t buffer_len = bufferlen;
 
     // INITIALIZING WEBGPU
     wgpu::Device device = context.device;
-    wgpu::Queue queue = context.queue;
 
     // shader file for complex subtraction
-    WorkgroupLimits limits = getWorkgroupLimits(device);
-    std::string shaderCode = readShaderFile("src/common/complex_sub/complex_sub.wgsl", limits.maxWorkgroupSizeX);
-    wgpu::ShaderModule shaderModule = createShaderModule(device, shaderCode);
+    LaunchConfig launch = linearLaunch(context, buffer_len);
+    CachedPipeline cached = getComputePipeline(context, "src/common/complex_sub/complex_sub.wgsl", createBindGroupLayout, launch.workgroupSizeX, 1, 1, fieldStorageConstants(storage, storage));
 
     // bind group/layout for complex subtraction
-    wgpu::BindGroupLayout bindGroupLayout = createBindGroupLayout(device);
+    wgpu::BindGroupLayout bindGroupLayout = cached.bindGroupLayout;
     wgpu::BindGroup bindGroup = createBindGroup(
         device, 
         bindGroupLayout, 
         inputBuffer1,
         inputBuffer2, 
-        outputBuffer
+        outputBuffer,
+        buffer_len,
+        storage
     );
 
     // perform complex subtraction
-    wgpu::ComputePipeline computePipeline = createComputePipeline(device, shaderModule, bindGroupLayout);
-    uint32_t workgroupsX = std::ceil(double(buffer_len)/limits.maxWorkgroupSizeX);
-    wgpu::CommandBuffer commandBuffer = createComputeCommandBuffer(device, computePipeline, bindGroup, workgroupsX);
-    queue.submit(1, &commandBuffer);
-
-    // Clean resources
-    commandBuffer.release();
-    computePipeline.release();
-    shaderModule.release();
-    bindGroup.release();
-    bindGroupLayout.release();
+    wgpu::ComputePipeline computePipeline = cached.pipeline;
+    dispatchCompute(context, computePipeline, bindGroup, launch);
 }
\ No newline at end of file
@@ -7,12 +7,15 @@
 #include <webgpu/webgpu.hpp>
 #include "../webgpu_utils.h"
 
+// outputBuffer = inputBuffer1 - inputBuffer2; storage applies to inputBuffer1 and
+// outputBuffer, inputBuffer2 is always f32
 void complex_sub(
     WebGPUContext& context, 
     wgpu::Buffer& outputBuffer, 
     wgpu::Buffer& inputBuffer1, 
     wgpu::Buffer& inputBuffer2,
-    size_t bufferlen
+    size_t bufferlen,
+    FieldStorage storage = FieldStorage::F32
 );
 
 #endif 
@@ -1,13 +1,15 @@
-@group(0) @binding(0) var<storage, read> ud: array<vec2<f32>>;
+{{ENABLE_F16}}
+
+@group(0) @binding(0) var<storage, read> ud: array<{{FIELD_IN}}>;
 @group(0) @binding(1) var<storage, read> fft: array<vec2<f32>>;
-@group(0) @binding(2) var<storage, read_write> out: array<vec2<f32>>;
+@group(0) @binding(2) var<storage, read_write> out: array<{{FIELD_OUT}}>;
 
 @compute @workgroup_size({{WORKGROUP_SIZE}})
-fn main(@builtin(global_invocation_id) id: vec3<u32>) {
-    let i = id.x;
+fn main(@builtin(global_invocation_id) id: vec3<u32>, @builtin(num_workgroups) num_groups: vec3<u32>) {
+    let i = id.x + id.y * num_groups.x * {{WORKGROUP_SIZE_X}}u;
     if (i >= arrayLength(&out)) {
         return;
     }
 
-    out[i] = ud[i] - fft[i];
+    out[i] = {{FIELD_OUT}}(vec2<f32>(ud[i]) - fft[i]);
 }
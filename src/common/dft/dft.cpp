@@ -1,7 +1,6 @@
 #include "dft.h"
 #include "../complex_scale/complex_scale.h"
-
-static size_t buffer_size;
+#include "../fft/twiddle.h"
 
 struct Params {
     int rows;
@@ -30,17 +29,22 @@ static wgpu::BindGroupLayout createBindGroupLayout(wgpu::Device& device) {
     inverseFlagLayout.visibility = wgpu::ShaderStage::Compute;
     inverseFlagLayout.buffer.type = wgpu::BufferBindingType::Uniform;
 
-    wgpu::BindGroupLayoutEntry entries[] = {inputBufferLayout, outputBufferLayout, uniformBufferLayout, inverseFlagLayout};
+    wgpu::BindGroupLayoutEntry twiddleBufferLayout = {};
+    twiddleBufferLayout.binding = 4;
+    twiddleBufferLayout.visibility = wgpu::ShaderStage::Compute;
+    twiddleBufferLayout.buffer.type = wgpu::BufferBindingType::ReadOnlyStorage;
+
+    wgpu::BindGroupLayoutEntry entries[] = {inputBufferLayout, outputBufferLayout, uniformBufferLayout, inverseFlagLayout, twiddleBufferLayout};
 
     wgpu::BindGroupLayoutDescriptor layoutDesc = {};
-    layoutDesc.entryCount = 4;      
+    layoutDesc.entryCount = 5;      
     layoutDesc.entries = entries;
 
     return device.createBindGroupLayout(layoutDesc);
 }
 
 // CREATING BIND GROUP
-static wgpu::BindGroup createBindGroup(wgpu::Device& device, wgpu::BindGroupLayout bindGroupLayout, wgpu::Buffer inputBuffer, wgpu::Buffer outputBuffer, wgpu::Buffer uniformBuffer, wgpu::Buffer inverseFlagBuffer) {
+static wgpu::BindGroup createBindGroup(wgpu::Device& device, wgpu::BindGroupLayout bindGroupLayout, wgpu::Buffer inputBuffer, wgpu::Buffer outputBuffer, wgpu::Buffer uniformBuffer, wgpu::Buffer inverseFlagBuffer, wgpu::Buffer twiddleBuffer, size_t buffer_size) {
     wgpu::BindGroupEntry inputEntry = {};
     inputEntry.binding = 0;
     inputEntry.buffer = inputBuffer;
@@ -65,11 +69,17 @@ static wgpu::BindGroup createBindGroup(wgpu::Device& device, wgpu::BindGroupLayo
     inverseFlagEntry.offset = 0;
     inverseFlagEntry.size = sizeof(uint32_t);  
     
-    wgpu::BindGroupEntry entries[] = {inputEntry, outputEntry, uniformEntry, inverseFlagEntry};
+    wgpu::BindGroupEntry twiddleEntry = {};
+    twiddleEntry.binding = 4;
+    twiddleEntry.buffer = twiddleBuffer;
+    twiddleEntry.offset = 0;
+    twiddleEntry.size = twiddleBuffer.getSize();
+
+    wgpu::BindGroupEntry entries[] = {inputEntry, outputEntry, uniformEntry, inverseFlagEntry, twiddleEntry};
 
     wgpu::BindGroupDescriptor bindGroupDesc = {};
     bindGroupDesc.layout = bindGroupLayout;
-    bindGroupDesc.entryCount = 4;
+    bindGroupDesc.entryCount = 5;
     bindGroupDesc.entries = entries;
 
     return device.createBindGroup(bindGroupDesc);
@@ -84,64 +94,42 @@ void dft(
     int cols, 
     uint32_t doInverse
 ) {
-    buffer_size = buffersize;
+    size_t buffer_size = buffersize;
     Params params = {rows, cols};
 
-    // Retrieve device and queue.
+    // Retrieve device.
     wgpu::Device device = context.device;
-    wgpu::Queue queue = context.queue;
-    WorkgroupLimits limits = getWorkgroupLimits(device);
-    limits.maxWorkgroupSizeX = std::min(limits.maxWorkgroupSizeX, sqrt(limits.maxInvocationsPerWorkgroup));
-    limits.maxWorkgroupSizeY = std::min(limits.maxWorkgroupSizeY, sqrt(limits.maxInvocationsPerWorkgroup));
+    LaunchConfig launch = gridLaunch(context, cols, rows);
 
     // Create the uniform buffer for dimensions.
-    wgpu::Buffer uniformBuffer = createBuffer(device, &params, sizeof(Params), wgpu::BufferUsage::Uniform);
+    PooledBuffer uniformBuffer = acquireBuffer(context, &params, sizeof(Params), wgpu::BufferUsage::Uniform);
 
     uint32_t inverseFlag = doInverse ? 1 : 0;
-    wgpu::Buffer inverseFlagBuffer = createBuffer(device, &inverseFlag, sizeof(uint32_t), wgpu::BufferUsage::Uniform);  
+    PooledBuffer inverseFlagBuffer = acquireBuffer(context, &inverseFlag, sizeof(uint32_t), wgpu::BufferUsage::Uniform);  
+
+    // Twiddle tables for each dimension, cached on the context
+    wgpu::Buffer rowTwiddles = getTwiddleTable(context, uint32_t(cols), inverseFlag != 0);
+    wgpu::Buffer colTwiddles = getTwiddleTable(context, uint32_t(rows), inverseFlag != 0);
 
     // ROW DFT PASS -> save output in intermediate buffer before column pass
-    wgpu::Buffer intermediateBuffer = createBuffer(device, nullptr, sizeof(float) * 2 * buffer_size, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc));
+    PooledBuffer intermediateBuffer = acquireBuffer(context, nullptr, sizeof(float) * 2 * buffer_size, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc));
 
-    std::string shaderCodeRow = readShaderFile("src/common/dft/dft_row.wgsl", limits.maxWorkgroupSizeX, limits.maxWorkgroupSizeY);
-    wgpu::ShaderModule shaderModuleRow = createShaderModule(device, shaderCodeRow);
+    CachedPipeline cachedRow = getComputePipeline(context, "src/common/dft/dft_row.wgsl", createBindGroupLayout, launch.workgroupSizeX, launch.workgroupSizeY);
 
-    wgpu::BindGroupLayout bindGroupLayout = createBindGroupLayout(device);
-    wgpu::BindGroup bindGroupRow = createBindGroup(device, bindGroupLayout, inputBuffer, intermediateBuffer, uniformBuffer, inverseFlagBuffer);
-    wgpu::ComputePipeline computePipelineRow = createComputePipeline(device, shaderModuleRow, bindGroupLayout);
+    wgpu::BindGroupLayout bindGroupLayout = cachedRow.bindGroupLayout;
+    wgpu::BindGroup bindGroupRow = createBindGroup(device, bindGroupLayout, inputBuffer, intermediateBuffer, uniformBuffer, inverseFlagBuffer, rowTwiddles, buffer_size);
+    wgpu::ComputePipeline computePipelineRow = cachedRow.pipeline;
 
-    // Note: same workgroups for row pass & col pass
-    uint32_t workgroupsX = std::ceil(double(cols)/limits.maxWorkgroupSizeX);
-    uint32_t workgroupsY = std::ceil(double(rows)/limits.maxWorkgroupSizeY);
+    // Note: same launch for row pass & col pass
+    dispatchCompute(context, computePipelineRow, bindGroupRow, launch);
 
-    wgpu::CommandBuffer commandBufferRow = createComputeCommandBuffer(device, computePipelineRow, bindGroupRow, workgroupsX, workgroupsY);
-    queue.submit(1, &commandBufferRow);
+    // COLUMN DFT PASS
+    CachedPipeline cachedCol = getComputePipeline(context, "src/common/dft/dft_col.wgsl", createBindGroupLayout, launch.workgroupSizeX, launch.workgroupSizeY);
 
-    // Clean row pass resources before doing column pass
-    commandBufferRow.release();
-    computePipelineRow.release();
-    bindGroupRow.release();
-    shaderModuleRow.release();
+    wgpu::BindGroup bindGroupCol = createBindGroup(device, cachedCol.bindGroupLayout, intermediateBuffer, finalOutputBuffer, uniformBuffer, inverseFlagBuffer, colTwiddles, buffer_size);
+    wgpu::ComputePipeline computePipelineCol = cachedCol.pipeline;
 
-    // COLUMN DFT PASS
-    std::string shaderCodeCol = readShaderFile("src/common/dft/dft_col.wgsl", limits.maxWorkgroupSizeX, limits.maxWorkgroupSizeY);
-    wgpu::ShaderModule shaderModuleCol = createShaderModule(device, shaderCodeCol);
-
-    wgpu::BindGroup bindGroupCol = createBindGroup(device, bindGroupLayout, intermediateBuffer, finalOutputBuffer, uniformBuffer, inverseFlagBuffer);
-    wgpu::ComputePipeline computePipelineCol = createComputePipeline(device, shaderModuleCol, bindGroupLayout);
-
-    wgpu::CommandBuffer commandBufferCol = createComputeCommandBuffer(device, computePipelineCol, bindGroupCol, workgroupsX, workgroupsY);
-    queue.submit(1, &commandBufferCol);
-
-    // Clean all resources
-    commandBufferCol.release();
-    computePipelineCol.release();
-    bindGroupCol.release();
-    bindGroupLayout.release();
-    shaderModuleCol.release();
-    uniformBuffer.release();
-    intermediateBuffer.release();
-    inverseFlagBuffer.release();
+    dispatchCompute(context, computePipelineCol, bindGroupCol, launch);
 }
 
 void dft_adjoint_forward(
@@ -153,15 +141,14 @@ void dft_adjoint_forward(
     int cols
 ) {
     // ADJOINT(FFT) = N * IFFT FOR THIS DFT NORMALIZATION
-    wgpu::Buffer tempBuffer = createBuffer(
-        context.device,
+    PooledBuffer tempBuffer = acquireBuffer(
+        context,
         nullptr,
         sizeof(float) * 2 * buffersize,
         WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
     );
     dft(context, tempBuffer, inputBuffer, buffersize, rows, cols, 1);
     complex_scale(context, outputBuffer, tempBuffer, buffersize, static_cast<float>(buffersize));
-    tempBuffer.release();
 }
 
 void dft_adjoint_inverse(
@@ -173,13 +160,12 @@ void dft_adjoint_inverse(
     int cols
 ) {
     // ADJOINT(IFFT) = FFT / N FOR THIS DFT NORMALIZATION
-    wgpu::Buffer tempBuffer = createBuffer(
-        context.device,
+    PooledBuffer tempBuffer = acquireBuffer(
+        context,
         nullptr,
         sizeof(float) * 2 * buffersize,
         WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
     );
     dft(context, tempBuffer, inputBuffer, buffersize, rows, cols, 0);
     complex_scale(context, outputBuffer, tempBuffer, buffersize, 1.0f / static_cast<float>(buffersize));
-    tempBuffer.release();
 }
@@ -2,6 +2,7 @@
 @group(0) @binding(1) var<storage, read_write> output: array<vec2<f32>>;
 @group(0) @binding(2) var<uniform> dims: vec2<i32>; // rows, cols
 @group(0) @binding(3) var<uniform> doInverse: u32; // IDFT flag
+@group(0) @binding(4) var<storage, read> twiddles: array<vec2<f32>>; // dims.x entries for this direction
 
 @compute @workgroup_size({{WORKGROUP_SIZE}})
 fn main(@builtin(global_invocation_id) global_id: vec3<u32>) {
@@ -12,16 +13,13 @@ fn main(@builtin(global_invocation_id) global_id: vec3<u32>) {
     }
     
     var sum = vec2<f32>(0.0, 0.0);
-    let pi = radians(180.0);
-    
-    // Determine sign based on inverse flag
-    let sign = select(-2.0, 2.0, doInverse == 1);
+
+    // Twiddle index (l * row) mod N, stepped incrementally to avoid overflow
+    var twiddle_idx = 0;
 
     // Compute DFT/IDFT
     for (var row = 0; row < dims.x; row = row + 1) {
-        let phase = fract(f32(row * l) / f32(dims.x)); // shrink phase to preserve precision
-        let angle = sign * pi * phase;
-        let euler = vec2<f32>(cos(angle), sin(angle));
+        let euler = twiddles[twiddle_idx];
         let idx = row * dims.y + col;
         let val = input[idx];
 
@@ -30,6 +28,7 @@ fn main(@builtin(global_invocation_id) global_id: vec3<u32>) {
             val.x * euler.x - val.y * euler.y,
             val.x * euler.y + val.y * euler.x
         );
+        twiddle_idx = (twiddle_idx + l) % dims.x;
     }
     
     // For IDFT, normalize by N (dims.x in this case)
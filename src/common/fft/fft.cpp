@@ -1,77 +1,16 @@
 #include "fft.h"
 #include "../dft/dft.h"
 #include "../complex_scale/complex_scale.h"
-#include <iostream>
-#include <cmath>
-
-static size_t buffer_size;
-
-struct FFTParams {
-    int rows;
-    int cols;
-    int stage;  // Which butterfly stage we're on
-};
-
-// CREATING BIND GROUP LAYOUT for FFT
-static wgpu::BindGroupLayout createFFTBindGroupLayout(wgpu::Device& device) {
-    wgpu::BindGroupLayoutEntry inputBufferLayout = {};
-    inputBufferLayout.binding = 0;
-    inputBufferLayout.visibility = wgpu::ShaderStage::Compute;
-    inputBufferLayout.buffer.type = wgpu::BufferBindingType::Storage;  // FFT needs read-write
-
-    wgpu::BindGroupLayoutEntry uniformBufferLayout = {};
-    uniformBufferLayout.binding = 1;
-    uniformBufferLayout.visibility = wgpu::ShaderStage::Compute;
-    uniformBufferLayout.buffer.type = wgpu::BufferBindingType::Uniform;
-
-    wgpu::BindGroupLayoutEntry inverseFlagLayout = {};
-    inverseFlagLayout.binding = 2;
-    inverseFlagLayout.visibility = wgpu::ShaderStage::Compute;
-    inverseFlagLayout.buffer.type = wgpu::BufferBindingType::Uniform;
-
-    wgpu::BindGroupLayoutEntry entries[] = {inputBufferLayout, uniformBufferLayout, inverseFlagLayout};
-
-    wgpu::BindGroupLayoutDescriptor layoutDesc = {};
-    layoutDesc.entryCount = 3;      
-    layoutDesc.entries = entries;
-
-    return device.createBindGroupLayout(layoutDesc);
-}
-
-// CREATING BIND GROUP for FFT
-static wgpu::BindGroup createFFTBindGroup(
-    wgpu::Device& device, 
-    wgpu::BindGroupLayout bindGroupLayout, 
-    wgpu::Buffer dataBuffer, 
-    wgpu::Buffer uniformBuffer, 
-    wgpu::Buffer inverseFlagBuffer
-) {
-    wgpu::BindGroupEntry inputEntry = {};
-    inputEntry.binding = 0;
-    inputEntry.buffer = dataBuffer;
-    inputEntry.offset = 0;
-    inputEntry.size = sizeof(float) * 2 * buffer_size;
-
-    wgpu::BindGroupEntry uniformEntry = {};
-    uniformEntry.binding = 1;
-    uniformEntry.buffer = uniformBuffer;
-    uniformEntry.offset = 0;
-    uniformEntry.size = sizeof(FFTParams);
-
-    wgpu::BindGroupEntry inverseFlagEntry = {};
-    inverseFlagEntry.binding = 2;
-    inverseFlagEntry.buffer = inverseFlagBuffer;
-    inverseFlagEntry.offset = 0;
-    inverseFlagEntry.size = sizeof(uint32_t);
-    
-    wgpu::BindGroupEntry entries[] = {inputEntry, uniformEntry, inverseFlagEntry};
-
-    wgpu::BindGroupDescriptor bindGroupDesc = {};
-    bindGroupDesc.layout = bindGroupLayout;
-    bindGroupDesc.entryCount = 3;
-    bindGroupDesc.entries = entries;
-
-    return device.createBindGroup(bindGroupDesc);
+#include "fft_plan.h"
+#include <stdexcept>
+
+// Number of rows x cols fields in a buffer of buffersize elements
+static int fieldBatch(size_t buffersize, int rows, int cols) {
+    size_t field_len = size_t(rows) * size_t(cols);
+    if (field_len == 0 || buffersize % field_len != 0) {
+        throw std::invalid_argument("fft buffer size is not a whole number of rows x cols fields");
+    }
+    return int(buffersize / field_len);
 }
 
 void fft(
@@ -82,209 +21,138 @@ void fft(
     int rows,
     int cols,
     uint32_t doInverse,
-    bool forceDft
+    bool forceDft,
+    FFTNorm norm,
+    FieldStorage inputStorage,
+    FieldStorage outputStorage
 ) {
-    if (forceDft || !isValidFFTDimensions(rows, cols)) {
-        dft(context, outputBuffer, inputBuffer, buffersize, rows, cols, doInverse);
+    int batch = fieldBatch(buffersize, rows, cols);
+    bool inPlace = outputBuffer == inputBuffer;
+    if (forceDft) {
+        if (batch != 1) {
+            throw std::invalid_argument("forced DFT transforms a single field");
+        }
+        if (inputStorage != FieldStorage::F32 || outputStorage != FieldStorage::F32) {
+            throw std::invalid_argument("forced DFT reads and writes f32 fields only");
+        }
+        // the DFT kernels normalize like FFTNorm::Backward; other modes rescale their result
+        float rescale = normScale(norm, doInverse != 0, buffersize) / normScale(FFTNorm::Backward, doInverse != 0, buffersize);
+        if (!inPlace && rescale == 1.0f) {
+            dft(context, outputBuffer, inputBuffer, buffersize, rows, cols, doInverse);
+            return;
+        }
+
+        // the DFT and scale kernels cannot read and write one buffer, so go through a temporary
+        PooledBuffer resultBuffer = acquireBuffer(context, nullptr, sizeof(float) * 2 * buffersize);
+        dft(context, resultBuffer, inputBuffer, buffersize, rows, cols, doInverse);
+        if (rescale != 1.0f) {
+            complex_scale(context, outputBuffer, resultBuffer, buffersize, rescale);
+        } else {
+            copyBufferToBuffer(context, resultBuffer, 0, outputBuffer, 0, sizeof(float) * 2 * buffersize);
+        }
         return;
     }
 
-    fftPowerOfTwo(context, outputBuffer, inputBuffer, buffersize, rows, cols, doInverse);
+    getFFTPlan(context, rows, cols, batch, doInverse != 0, inPlace, norm, inputStorage, outputStorage).execute(context, outputBuffer, inputBuffer);
 }
 
-void fftPowerOfTwo(
+// Records a plan with elementwise work fused into its first read and last write
+static void fusedFFT(
     WebGPUContext& context,
     wgpu::Buffer& outputBuffer,
     wgpu::Buffer& inputBuffer,
+    wgpu::Buffer& factorBuffer,
+    wgpu::Buffer& minuendBuffer,
     size_t buffersize,
     int rows,
     int cols,
-    uint32_t doInverse
+    uint32_t doInverse,
+    FFTNorm norm,
+    FieldStorage inputStorage,
+    FieldStorage outputStorage,
+    FFTFusion fusion
 ) {
-    buffer_size = buffersize;
-    
-    wgpu::Device device = context.device;
-    wgpu::Queue queue = context.queue;
-    WorkgroupLimits limits = getWorkgroupLimits(device);
-    limits.maxWorkgroupSizeX = std::min(limits.maxWorkgroupSizeX, sqrt(limits.maxInvocationsPerWorkgroup));
-    limits.maxWorkgroupSizeY = std::min(limits.maxWorkgroupSizeY, sqrt(limits.maxInvocationsPerWorkgroup));
-
-    // Create temporary buffer for in-place FFT computation (copy input to output first)
-    wgpu::Buffer workBuffer = createBuffer(device, nullptr, sizeof(float) * 2 * buffer_size, 
-        WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst));
-
-    // Copy input to work buffer
-    wgpu::CommandEncoder encoder = device.createCommandEncoder();
-    encoder.copyBufferToBuffer(inputBuffer, 0, workBuffer, 0, sizeof(float) * 2 * buffer_size);
-    wgpu::CommandBuffer cmdBuffer = encoder.finish();
-    queue.submit(1, &cmdBuffer);
-    cmdBuffer.release();
-
-    uint32_t inverseFlag = doInverse ? 1 : 0;
-    wgpu::Buffer inverseFlagBuffer = createBuffer(device, &inverseFlag, sizeof(uint32_t), wgpu::BufferUsage::Uniform);
-
-    // ==================== ROW FFT ====================
-    {
-        wgpu::BindGroupLayout bindGroupLayout = createFFTBindGroupLayout(device);
-        
-        // Bit-reversal pass for rows
-        std::string bitRevShaderCode = readShaderFile("src/common/fft/fft_bit_reversal.wgsl", limits.maxWorkgroupSizeX, limits.maxWorkgroupSizeY);
-        wgpu::ShaderModule bitRevShaderModule = createShaderModule(device, bitRevShaderCode);
-        
-        FFTParams params = {rows, cols, 0};
-        wgpu::Buffer paramsBuffer = createBuffer(device, &params, sizeof(FFTParams), wgpu::BufferUsage::Uniform);
-        
-        wgpu::BindGroup bindGroup = createFFTBindGroup(device, bindGroupLayout, workBuffer, paramsBuffer, inverseFlagBuffer);
-        wgpu::ComputePipeline pipeline = createComputePipeline(device, bitRevShaderModule, bindGroupLayout);
-        
-        uint32_t workgroupsX = std::ceil(double(cols) / limits.maxWorkgroupSizeX);
-        uint32_t workgroupsY = std::ceil(double(rows) / limits.maxWorkgroupSizeY);
-        
-        wgpu::CommandBuffer commandBuffer = createComputeCommandBuffer(device, pipeline, bindGroup, workgroupsX, workgroupsY);
-        queue.submit(1, &commandBuffer);
-        
-        commandBuffer.release();
-        pipeline.release();
-        bindGroup.release();
-        bitRevShaderModule.release();
-        paramsBuffer.release();
-        bindGroupLayout.release();
-    }
-
-    // Butterfly passes for rows (log2(cols) stages)
-    int numStagesRow = log2Int(cols);
-    for (int stage = 0; stage < numStagesRow; stage++) {
-        wgpu::BindGroupLayout bindGroupLayout = createFFTBindGroupLayout(device);
-        
-        std::string butterflyShaderCode = readShaderFile("src/common/fft/fft_butterfly.wgsl", limits.maxWorkgroupSizeX, limits.maxWorkgroupSizeY);
-        wgpu::ShaderModule butterflyShaderModule = createShaderModule(device, butterflyShaderCode);
-        
-        FFTParams params = {rows, cols, stage};
-        wgpu::Buffer paramsBuffer = createBuffer(device, &params, sizeof(FFTParams), wgpu::BufferUsage::Uniform);
-        
-        wgpu::BindGroup bindGroup = createFFTBindGroup(device, bindGroupLayout, workBuffer, paramsBuffer, inverseFlagBuffer);
-        wgpu::ComputePipeline pipeline = createComputePipeline(device, butterflyShaderModule, bindGroupLayout);
-        
-        uint32_t workgroupsX = std::ceil(double(cols) / limits.maxWorkgroupSizeX);
-        uint32_t workgroupsY = std::ceil(double(rows) / limits.maxWorkgroupSizeY);
-        
-        wgpu::CommandBuffer commandBuffer = createComputeCommandBuffer(device, pipeline, bindGroup, workgroupsX, workgroupsY);
-        queue.submit(1, &commandBuffer);
-        
-        commandBuffer.release();
-        pipeline.release();
-        bindGroup.release();
-        butterflyShaderModule.release();
-        paramsBuffer.release();
-        bindGroupLayout.release();
-    }
-
-    // ==================== COLUMN FFT ====================
-    {
-        wgpu::BindGroupLayout bindGroupLayout = createFFTBindGroupLayout(device);
-        
-        // Bit-reversal pass for columns
-        std::string bitRevShaderCode = readShaderFile("src/common/fft/fft_bit_reversal_col.wgsl", limits.maxWorkgroupSizeX, limits.maxWorkgroupSizeY);
-        wgpu::ShaderModule bitRevShaderModule = createShaderModule(device, bitRevShaderCode);
-        
-        FFTParams params = {rows, cols, 0};
-        wgpu::Buffer paramsBuffer = createBuffer(device, &params, sizeof(FFTParams), wgpu::BufferUsage::Uniform);
-        
-        wgpu::BindGroup bindGroup = createFFTBindGroup(device, bindGroupLayout, workBuffer, paramsBuffer, inverseFlagBuffer);
-        wgpu::ComputePipeline pipeline = createComputePipeline(device, bitRevShaderModule, bindGroupLayout);
-        
-        uint32_t workgroupsX = std::ceil(double(cols) / limits.maxWorkgroupSizeX);
-        uint32_t workgroupsY = std::ceil(double(rows) / limits.maxWorkgroupSizeY);
-        
-        wgpu::CommandBuffer commandBuffer = createComputeCommandBuffer(device, pipeline, bindGroup, workgroupsX, workgroupsY);
-        queue.submit(1, &commandBuffer);
-        
-        commandBuffer.release();
-        pipeline.release();
-        bindGroup.release();
-        bitRevShaderModule.release();
-        paramsBuffer.release();
-        bindGroupLayout.release();
+    if (outputBuffer == inputBuffer) {
+        throw std::invalid_argument("fused fft cannot transform in place");
     }
+    getFFTPlan(context, rows, cols, fieldBatch(buffersize, rows, cols), doInverse != 0, false, norm, inputStorage, outputStorage, fusion)
+        .execute(context, outputBuffer, inputBuffer, factorBuffer, minuendBuffer);
+}
 
-    // Butterfly passes for columns (log2(rows) stages)
-    int numStagesCol = log2Int(rows);
-    for (int stage = 0; stage < numStagesCol; stage++) {
-        wgpu::BindGroupLayout bindGroupLayout = createFFTBindGroupLayout(device);
-        
-        std::string butterflyShaderCode = readShaderFile("src/common/fft/fft_butterfly_col.wgsl", limits.maxWorkgroupSizeX, limits.maxWorkgroupSizeY);
-        wgpu::ShaderModule butterflyShaderModule = createShaderModule(device, butterflyShaderCode);
-        
-        FFTParams params = {rows, cols, stage};
-        wgpu::Buffer paramsBuffer = createBuffer(device, &params, sizeof(FFTParams), wgpu::BufferUsage::Uniform);
-        
-        wgpu::BindGroup bindGroup = createFFTBindGroup(device, bindGroupLayout, workBuffer, paramsBuffer, inverseFlagBuffer);
-        wgpu::ComputePipeline pipeline = createComputePipeline(device, butterflyShaderModule, bindGroupLayout);
-        
-        uint32_t workgroupsX = std::ceil(double(cols) / limits.maxWorkgroupSizeX);
-        uint32_t workgroupsY = std::ceil(double(rows) / limits.maxWorkgroupSizeY);
-        
-        wgpu::CommandBuffer commandBuffer = createComputeCommandBuffer(device, pipeline, bindGroup, workgroupsX, workgroupsY);
-        queue.submit(1, &commandBuffer);
-        
-        commandBuffer.release();
-        pipeline.release();
-        bindGroup.release();
-        butterflyShaderModule.release();
-        paramsBuffer.release();
-        bindGroupLayout.release();
-    }
+void fft_premultiply(
+    WebGPUContext& context,
+    wgpu::Buffer& outputBuffer,
+    wgpu::Buffer& inputBuffer,
+    wgpu::Buffer& factorBuffer,
+    size_t buffersize,
+    int rows,
+    int cols,
+    uint32_t doInverse,
+    FFTNorm norm
+) {
+    FFTFusion fusion;
+    fusion.multiplyInput = true;
+    wgpu::Buffer noMinuend = nullptr;
+    fusedFFT(context, outputBuffer, inputBuffer, factorBuffer, noMinuend, buffersize, rows, cols, doInverse, norm, FieldStorage::F32, FieldStorage::F32, fusion);
+}
 
-    // Copy result to output buffer
-    {
-        wgpu::CommandEncoder encoder = device.createCommandEncoder();
-        encoder.copyBufferToBuffer(workBuffer, 0, outputBuffer, 0, sizeof(float) * 2 * buffer_size);
-        wgpu::CommandBuffer cmdBuffer = encoder.finish();
-        queue.submit(1, &cmdBuffer);
-        cmdBuffer.release();
-    }
+void fft_postmultiply(
+    WebGPUContext& context,
+    wgpu::Buffer& outputBuffer,
+    wgpu::Buffer& inputBuffer,
+    wgpu::Buffer& factorBuffer,
+    size_t buffersize,
+    int rows,
+    int cols,
+    uint32_t doInverse,
+    FFTNorm norm
+) {
+    FFTFusion fusion;
+    fusion.multiplyOutput = true;
+    wgpu::Buffer noMinuend = nullptr;
+    fusedFFT(context, outputBuffer, inputBuffer, factorBuffer, noMinuend, buffersize, rows, cols, doInverse, norm, FieldStorage::F32, FieldStorage::F32, fusion);
+}
 
-    // Cleanup
-    workBuffer.release();
-    inverseFlagBuffer.release();
+void fft_multiply_subtract(
+    WebGPUContext& context,
+    wgpu::Buffer& outputBuffer,
+    wgpu::Buffer& inputBuffer,
+    wgpu::Buffer& factorBuffer,
+    wgpu::Buffer& minuendBuffer,
+    size_t buffersize,
+    int rows,
+    int cols,
+    uint32_t doInverse,
+    FFTNorm norm,
+    FieldStorage inputStorage,
+    FieldStorage outputStorage
+) {
+    FFTFusion fusion;
+    fusion.multiplyInput = true;
+    fusion.subtractFromMinuend = true;
+    fusedFFT(context, outputBuffer, inputBuffer, factorBuffer, minuendBuffer, buffersize, rows, cols, doInverse, norm, inputStorage, outputStorage, fusion);
 }
 
-void fft_adjoint_forward(
+void rfft(
     WebGPUContext& context,
     wgpu::Buffer& outputBuffer,
     wgpu::Buffer& inputBuffer,
     size_t buffersize,
     int rows,
     int cols,
-    bool forceDft
+    FFTNorm norm
 ) {
-    wgpu::Buffer tempBuffer = createBuffer(
-        context.device,
-        nullptr,
-        sizeof(float) * 2 * buffersize,
-        WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
-    );
-    fft(context, tempBuffer, inputBuffer, buffersize, rows, cols, 1, forceDft);
-    complex_scale(context, outputBuffer, tempBuffer, buffersize, static_cast<float>(buffersize));
-    tempBuffer.release();
+    getRealFFTPlan(context, rows, cols, fieldBatch(buffersize, rows, cols), false, norm).execute(context, outputBuffer, inputBuffer);
 }
 
-void fft_adjoint_inverse(
+void irfft(
     WebGPUContext& context,
     wgpu::Buffer& outputBuffer,
     wgpu::Buffer& inputBuffer,
     size_t buffersize,
     int rows,
     int cols,
-    bool forceDft
+    FFTNorm norm
 ) {
-    wgpu::Buffer tempBuffer = createBuffer(
-        context.device,
-        nullptr,
-        sizeof(float) * 2 * buffersize,
-        WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
-    );
-    fft(context, tempBuffer, inputBuffer, buffersize, rows, cols, 0, forceDft);
-    complex_scale(context, outputBuffer, tempBuffer, buffersize, 1.0f / static_cast<float>(buffersize));
-    tempBuffer.release();
+    getRealFFTPlan(context, rows, cols, fieldBatch(buffersize, rows, cols), true, norm).execute(context, outputBuffer, inputBuffer);
 }
@@ -5,7 +5,17 @@
 #include "../webgpu_utils.h"
 #include "fft_utils.h"
 
-// Barebones API entry point allowing forced DFT
+// Barebones API entry point allowing forced DFT.
+// Any rows x cols shape runs in O(N log N): lengths factoring into 2, 3, 5 and 7 use
+// mixed-radix Stockham stages (in workgroup memory when a line fits, otherwise one
+// global pass per stage); other lengths use Bluestein's chirp-z convolution.
+// buffersize may cover a contiguous batch of rows x cols fields, which are all
+// transformed in the same dispatches. outputBuffer may be inputBuffer for an
+// in-place transform; either way the last pass writes straight into outputBuffer.
+// norm picks the scaling (see FFTNorm), applied in that same last pass. The adjoint
+// of the forward transform is the inverse with FFTNorm::None, and the adjoint of the
+// inverse is the forward transform with FFTNorm::Forward. inputStorage and outputStorage
+// give the precision of the two buffers (f16 needs capabilities.shaderF16).
 void fft(
     WebGPUContext& context,
     wgpu::Buffer& outputBuffer,
@@ -14,38 +24,80 @@ void fft(
     int rows,
     int cols,
     uint32_t doInverse,
-    bool forceDft = false
+    bool forceDft = false,
+    FFTNorm norm = FFTNorm::Backward,
+    FieldStorage inputStorage = FieldStorage::F32,
+    FieldStorage outputStorage = FieldStorage::F32
 );
 
-// Internal Cooley-Tukey implementation for power-of-2 dimensions.
-void fftPowerOfTwo(
+// outputBuffer = fft(inputBuffer * factorBuffer) and outputBuffer = fft(inputBuffer) * factorBuffer,
+// with the multiply folded into the first read or the last write of the transform.
+// factorBuffer is a single rows x cols complex field applied to every field of the batch.
+void fft_premultiply(
     WebGPUContext& context,
     wgpu::Buffer& outputBuffer,
     wgpu::Buffer& inputBuffer,
+    wgpu::Buffer& factorBuffer,
     size_t buffersize,
     int rows,
     int cols,
-    uint32_t doInverse
+    uint32_t doInverse,
+    FFTNorm norm = FFTNorm::Backward
+);
+void fft_postmultiply(
+    WebGPUContext& context,
+    wgpu::Buffer& outputBuffer,
+    wgpu::Buffer& inputBuffer,
+    wgpu::Buffer& factorBuffer,
+    size_t buffersize,
+    int rows,
+    int cols,
+    uint32_t doInverse,
+    FFTNorm norm = FFTNorm::Backward
+);
+
+// outputBuffer = minuendBuffer - fft(inputBuffer * factorBuffer) in the passes of the
+// transform alone: the multiply is folded into the first read and the subtraction into
+// the last write. factorBuffer is a single rows x cols complex field applied to every
+// field of the batch; minuendBuffer has the output's layout and storage and must not
+// be outputBuffer.
+void fft_multiply_subtract(
+    WebGPUContext& context,
+    wgpu::Buffer& outputBuffer,
+    wgpu::Buffer& inputBuffer,
+    wgpu::Buffer& factorBuffer,
+    wgpu::Buffer& minuendBuffer,
+    size_t buffersize,
+    int rows,
+    int cols,
+    uint32_t doInverse,
+    FFTNorm norm = FFTNorm::Backward,
+    FieldStorage inputStorage = FieldStorage::F32,
+    FieldStorage outputStorage = FieldStorage::F32
 );
 
-void fft_adjoint_forward(
+// Real-to-complex forward FFT of real rows x cols fields (buffersize floats, may be a batch).
+// Only the non-redundant half spectrum is computed and written: rows x (cols / 2 + 1)
+// complex values per field, the rest follows from X[-k] = conj(X[k]).
+void rfft(
     WebGPUContext& context,
     wgpu::Buffer& outputBuffer,
     wgpu::Buffer& inputBuffer,
     size_t buffersize,
     int rows,
     int cols,
-    bool forceDft = false
+    FFTNorm norm = FFTNorm::Backward
 );
 
-void fft_adjoint_inverse(
+// Complex-to-real inverse of rfft; buffersize counts the real output floats
+void irfft(
     WebGPUContext& context,
     wgpu::Buffer& outputBuffer,
     wgpu::Buffer& inputBuffer,
     size_t buffersize,
     int rows,
     int cols,
-    bool forceDft = false
+    FFTNorm norm = FFTNorm::Backward
 );
 
 #endif // FFT_H
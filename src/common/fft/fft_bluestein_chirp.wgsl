@@ -0,0 +1,49 @@
+{{ENABLE_F16}}
+
+struct BluesteinParams {
+    n: u32,           // transform length
+    m: u32,           // padded power-of-2 convolution length, >= 2n - 1
+    lines: u32,
+    line_stride: u32,
+    elem_stride: u32,
+    scale: f32,       // applied by the postmultiply
+    lines_per_batch: u32, // lines of one batch member
+    batch_stride: u32,    // distance between consecutive batch members
+}
+
+@group(0) @binding(0) var<storage, read> input: array<{{FIELD_IN}}>;
+@group(0) @binding(1) var<storage, read_write> output: array<vec2<f32>>; // lines x m, packed
+@group(0) @binding(2) var<uniform> params: BluesteinParams;
+@group(0) @binding(3) var<storage, read> chirp: array<vec2<f32>>; // exp(∓iπ k² / n)
+{{FUSED_OPERAND}}
+
+// Input element i, times the factor when the plan fuses a multiply into its first read
+fn load_input(i: u32) -> vec2<f32> {
+    var x = vec2<f32>(input[i]);
+    {{FUSED_LOAD}}
+    return x;
+}
+
+fn line_base(line: u32) -> u32 {
+    return (line / params.lines_per_batch) * params.batch_stride + (line % params.lines_per_batch) * params.line_stride;
+}
+
+// Bluestein premultiply: a[k] = x[k] * chirp[k], zero-padded to m
+@compute @workgroup_size({{WORKGROUP_SIZE}})
+fn main(@builtin(global_invocation_id) global_id: vec3<u32>, @builtin(num_workgroups) num_groups: vec3<u32>) {
+    let idx = global_id.x + global_id.y * num_groups.x * {{WORKGROUP_SIZE_X}}u;
+    if (idx >= params.lines * params.m) {
+        return;
+    }
+
+    let line = idx / params.m;
+    let k = idx % params.m;
+    if (k >= params.n) {
+        output[idx] = vec2<f32>(0.0, 0.0);
+        return;
+    }
+
+    let x = load_input(line_base(line) + k * params.elem_stride);
+    let w = chirp[k];
+    output[idx] = vec2<f32>(x.x * w.x - x.y * w.y, x.x * w.y + x.y * w.x);
+}
@@ -0,0 +1,16 @@
+@group(0) @binding(0) var<storage, read_write> data: array<vec2<f32>>; // lines x m, packed
+@group(0) @binding(1) var<uniform> params: vec2<u32>; // m, lines
+@group(0) @binding(2) var<storage, read> spectrum: array<vec2<f32>>; // FFT of the conjugate chirp, m entries
+
+// Pointwise product with the chirp filter spectrum, in place
+@compute @workgroup_size({{WORKGROUP_SIZE}})
+fn main(@builtin(global_invocation_id) global_id: vec3<u32>, @builtin(num_workgroups) num_groups: vec3<u32>) {
+    let idx = global_id.x + global_id.y * num_groups.x * {{WORKGROUP_SIZE_X}}u;
+    if (idx >= params.x * params.y) {
+        return;
+    }
+
+    let a = data[idx];
+    let b = spectrum[idx % params.x];
+    data[idx] = vec2<f32>(a.x * b.x - a.y * b.y, a.x * b.y + a.y * b.x);
+}
@@ -0,0 +1,45 @@
+{{ENABLE_F16}}
+
+struct BluesteinParams {
+    n: u32,           // transform length
+    m: u32,           // padded power-of-2 convolution length, >= 2n - 1
+    lines: u32,
+    line_stride: u32,
+    elem_stride: u32,
+    scale: f32,       // normalization of the whole transform
+    lines_per_batch: u32, // lines of one batch member
+    batch_stride: u32,    // distance between consecutive batch members
+}
+
+@group(0) @binding(0) var<storage, read> input: array<vec2<f32>>; // lines x m, packed
+@group(0) @binding(1) var<storage, read_write> output: array<{{FIELD_OUT}}>;
+@group(0) @binding(2) var<uniform> params: BluesteinParams;
+@group(0) @binding(3) var<storage, read> chirp: array<vec2<f32>>; // exp(∓iπ k² / n)
+{{FUSED_OPERAND}}
+
+// Writes output element i, subtracted from the minuend when the plan fuses one into its last write
+fn store_output(i: u32, result: vec2<f32>) {
+    var value = result;
+    {{FUSED_STORE}}
+    output[i] = {{FIELD_OUT}}(value);
+}
+
+fn line_base(line: u32) -> u32 {
+    return (line / params.lines_per_batch) * params.batch_stride + (line % params.lines_per_batch) * params.line_stride;
+}
+
+// Bluestein postmultiply: X[k] = scale * chirp[k] * conv[k]
+@compute @workgroup_size({{WORKGROUP_SIZE}})
+fn main(@builtin(global_invocation_id) global_id: vec3<u32>, @builtin(num_workgroups) num_groups: vec3<u32>) {
+    let idx = global_id.x + global_id.y * num_groups.x * {{WORKGROUP_SIZE_X}}u;
+    if (idx >= params.lines * params.n) {
+        return;
+    }
+
+    let line = idx / params.n;
+    let k = idx % params.n;
+
+    let c = input[line * params.m + k];
+    let w = chirp[k];
+    store_output(line_base(line) + k * params.elem_stride, params.scale * vec2<f32>(c.x * w.x - c.y * w.y, c.x * w.y + c.y * w.x));
+}
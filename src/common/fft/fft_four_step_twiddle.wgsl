@@ -0,0 +1,45 @@
+struct TransposeParams {
+    rows: u32, // of each input field; the output fields are cols x rows
+    cols: u32,
+    batch: u32,
+    pad0: u32,
+}
+
+@group(0) @binding(0) var<storage, read> input: array<vec2<f32>>;
+@group(0) @binding(1) var<storage, read_write> output: array<vec2<f32>>;
+@group(0) @binding(2) var<uniform> params: TransposeParams;
+@group(0) @binding(3) var<storage, read> twiddles: array<vec2<f32>>; // rows * cols entries for this direction
+
+const TILE: u32 = {{WORKGROUP_SIZE_X}}u;
+
+// Padded by one column so the transposed reads hit distinct banks
+var<workgroup> tile: array<vec2<f32>, {{WORKGROUP_SIZE_X}} * ({{WORKGROUP_SIZE_X}} + 1)>;
+
+fn complex_mul(a: vec2<f32>, b: vec2<f32>) -> vec2<f32> {
+    return vec2<f32>(a.x * b.x - a.y * b.y, a.x * b.y + a.y * b.x);
+}
+
+// Middle pass of the six-step FFT of lines of length n = rows * cols: the tiled
+// transpose of fft_transpose.wgsl, with element (row, col) multiplied by W_n^(row * col)
+// on its way out.
+@compute @workgroup_size({{WORKGROUP_SIZE}})
+fn main(
+    @builtin(local_invocation_id) local_id: vec3<u32>,
+    @builtin(workgroup_id) group_id: vec3<u32>
+) {
+    let base = group_id.z * params.rows * params.cols;
+
+    let col = group_id.x * TILE + local_id.x;
+    let row = group_id.y * TILE + local_id.y;
+    if (row < params.rows && col < params.cols) {
+        tile[local_id.y * (TILE + 1u) + local_id.x] = input[base + row * params.cols + col];
+    }
+    workgroupBarrier();
+
+    let out_row = group_id.x * TILE + local_id.y;
+    let out_col = group_id.y * TILE + local_id.x;
+    if (out_row < params.cols && out_col < params.rows) {
+        let value = tile[local_id.x * (TILE + 1u) + local_id.y];
+        output[base + out_row * params.rows + out_col] = complex_mul(value, twiddles[out_row * out_col]);
+    }
+}
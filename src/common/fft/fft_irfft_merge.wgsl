@@ -0,0 +1,38 @@
+struct RealParams {
+    n: u32,     // real line length
+    lines: u32, // number of lines (rows of every batch member)
+    pad0: u32,
+    pad1: u32,
+}
+
+@group(0) @binding(0) var<storage, read> input: array<vec2<f32>>;      // lines x (n/2 + 1) half spectrum
+@group(0) @binding(1) var<storage, read_write> output: array<vec2<f32>>; // lines x n/2 packed spectrum
+@group(0) @binding(2) var<uniform> params: RealParams;
+@group(0) @binding(3) var<storage, read> twiddles: array<vec2<f32>>; // n inverse entries
+
+fn complex_mul(a: vec2<f32>, b: vec2<f32>) -> vec2<f32> {
+    return vec2<f32>(a.x * b.x - a.y * b.y, a.x * b.y + a.y * b.x);
+}
+
+// Even n, inverse of fft_rfft_split: E[k] = (X[k] + conj(X[h-k])) / 2 and
+// O[k] = (X[k] - conj(X[h-k])) / 2 * W^-k, packed as Z[k] = E[k] + i O[k]. The
+// length-n/2 inverse FFT of Z yields x[2j] + i x[2j+1], i.e. the real line in place.
+@compute @workgroup_size({{WORKGROUP_SIZE}})
+fn main(@builtin(global_invocation_id) global_id: vec3<u32>, @builtin(num_workgroups) num_groups: vec3<u32>) {
+    let idx = global_id.x + global_id.y * num_groups.x * {{WORKGROUP_SIZE_X}}u;
+    let h = params.n / 2u;
+    if (idx >= params.lines * h) {
+        return;
+    }
+
+    let line = idx / h;
+    let k = idx % h;
+    let x = input[line * (h + 1u) + k];
+    let xc = input[line * (h + 1u) + h - k];
+    let xc_conj = vec2<f32>(xc.x, -xc.y);
+
+    let even = 0.5 * (x + xc_conj);
+    let odd = complex_mul(0.5 * (x - xc_conj), twiddles[k]);
+
+    output[idx] = even + vec2<f32>(-odd.y, odd.x); // E + i O
+}
@@ -0,0 +1,989 @@
+#include "fft_plan.h"
+#include "fft_utils.h"
+#include "twiddle.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <initializer_list>
+#include <utility>
+#include <stdexcept>
+#include <string>
+
+// Stockham stages per line are bounded by log2 of the longest line
+static constexpr size_t maxStockhamStages = 32;
+
+struct StockhamParams {
+    uint32_t stages;
+    uint32_t lines;
+    uint32_t lineStride;
+    uint32_t elemStride;
+    float scale;
+    uint32_t linesPerBatch;
+    uint32_t batchStride;
+    uint32_t pad0;
+    uint32_t radices[maxStockhamStages];
+};
+
+struct StageParams {
+    uint32_t n;
+    uint32_t lines;
+    uint32_t lineStride;
+    uint32_t elemStride;
+    uint32_t radix;
+    uint32_t span;
+    float scale;
+    uint32_t linesPerBatch;
+    uint32_t batchStride;
+    uint32_t pad0;
+    uint32_t pad1;
+    uint32_t pad2;
+};
+
+struct TransposeParams {
+    uint32_t rows;
+    uint32_t cols;
+    uint32_t batch;
+    uint32_t pad0;
+};
+
+struct RealParams {
+    uint32_t n;
+    uint32_t lines;
+    uint32_t pad0;
+    uint32_t pad1;
+};
+
+struct BluesteinParams {
+    uint32_t n;
+    uint32_t m;
+    uint32_t lines;
+    uint32_t lineStride;
+    uint32_t elemStride;
+    float scale;
+    uint32_t linesPerBatch;
+    uint32_t batchStride;
+};
+
+// Strided lines of a complex buffer. Line l starts at
+// (l / linesPerBatch) * batchStride + (l % linesPerBatch) * lineStride and its
+// elements are elemStride apart.
+struct FFTPlan::LineLayout {
+    uint32_t n;
+    uint32_t lines;
+    uint32_t lineStride;
+    uint32_t elemStride;
+    uint32_t linesPerBatch;
+    uint32_t batchStride;
+};
+
+// Buffer slots a step reads and writes; temporaries follow the caller's buffers
+enum : uint32_t {
+    InputSlot = 0,
+    OutputSlot = 1,
+    FactorSlot = 2,  // fused multiply of the first read
+    MinuendSlot = 3, // fused subtraction of the last write
+    FirstTemporarySlot = 4,
+    NoSlot = 0xffffffffu,
+};
+
+enum class StepKind {
+    Transform, // source -> target with a lookup table
+    Filter,    // in place on the target
+    Transpose, // source -> target, no table (also the real-FFT packing kernels)
+};
+
+// How a step's launch grows with the batch
+enum class LaunchKind {
+    Linear, // linearLaunch over launchCount invocations per field
+    Groups, // groupLaunch of launchCount workgroups per field
+    Grid,   // gridLaunch tiles, launchCount transposed fields per FFT field in workgroup_id.z
+};
+
+static uint64_t complexBytes(size_t len) {
+    return sizeof(float) * 2 * len;
+}
+
+// One recorded dispatch. Plans are built for a single field: the uniform, launch and
+// binding sizes below are per field and record() scales them by the batch.
+struct FFTPlan::Step {
+    StepKind kind = StepKind::Transform;
+    CachedPipeline cached;
+    LaunchConfig launch;
+    LaunchKind launchKind = LaunchKind::Linear;
+    size_t launchCount = 0;
+    std::vector<uint32_t> paramsWords;
+    std::vector<size_t> batchedWords; // uniform words counting lines or fields
+    size_t paramsSize = 0;
+    PooledBuffer params; // paramsWords scaled to paramsBatch
+    uint32_t paramsBatch = 0;
+    wgpu::Buffer table = nullptr;
+    uint32_t source = InputSlot;
+    uint64_t sourceBytes = 0;
+    uint32_t target = OutputSlot;
+    uint64_t targetBytes = 0;
+    uint32_t operand = NoSlot; // FactorSlot or MinuendSlot at binding 4 on fused steps
+    uint64_t operandBytes = 0;
+
+    wgpu::BindGroup bindGroup = nullptr;
+    wgpu::Buffer boundSource = nullptr;
+    wgpu::Buffer boundTarget = nullptr;
+    wgpu::Buffer boundOperand = nullptr;
+    uint32_t boundBatch = 0;
+};
+
+// Stores a step's uniform for one field; the listed words scale with the batch
+template <typename Params>
+static void setStepParams(FFTPlan::Step& step, const Params& params, std::initializer_list<size_t> batchedWords) {
+    static_assert(sizeof(Params) % sizeof(uint32_t) == 0, "FFT uniforms are made of 32-bit words");
+    step.paramsWords.resize(sizeof(Params) / sizeof(uint32_t));
+    std::memcpy(step.paramsWords.data(), &params, sizeof(Params));
+    step.paramsSize = sizeof(Params);
+    step.batchedWords = batchedWords;
+}
+
+// The step's launch over batch fields
+static LaunchConfig batchLaunch(const WebGPUContext& context, const FFTPlan::Step& step, uint32_t batch) {
+    size_t count = step.launchCount * batch;
+    switch (step.launchKind) {
+    case LaunchKind::Groups:
+        return groupLaunch(context, count, step.launch.workgroupSizeX);
+    case LaunchKind::Grid: {
+        if (count > context.capabilities.maxWorkgroupsPerDimension) {
+            throw std::runtime_error("FFT transpose of " + std::to_string(count) + " fields exceeds the device dispatch limits");
+        }
+        LaunchConfig launch = step.launch;
+        launch.workgroupsZ = uint32_t(count);
+        return launch;
+    }
+    default:
+        return linearLaunch(context, count);
+    }
+}
+
+// CREATING BIND GROUP LAYOUT for input -> output passes, with a lookup table at binding 3
+// and the fused factor or minuend at binding 4
+static wgpu::BindGroupLayout buildTransformBindGroupLayout(wgpu::Device& device, bool withTable, bool withOperand) {
+    wgpu::BindGroupLayoutEntry inputBufferLayout = {};
+    inputBufferLayout.binding = 0;
+    inputBufferLayout.visibility = wgpu::ShaderStage::Compute;
+    inputBufferLayout.buffer.type = wgpu::BufferBindingType::ReadOnlyStorage;
+
+    wgpu::BindGroupLayoutEntry outputBufferLayout = {};
+    outputBufferLayout.binding = 1;
+    outputBufferLayout.visibility = wgpu::ShaderStage::Compute;
+    outputBufferLayout.buffer.type = wgpu::BufferBindingType::Storage;
+
+    wgpu::BindGroupLayoutEntry uniformBufferLayout = {};
+    uniformBufferLayout.binding = 2;
+    uniformBufferLayout.visibility = wgpu::ShaderStage::Compute;
+    uniformBufferLayout.buffer.type = wgpu::BufferBindingType::Uniform;
+
+    wgpu::BindGroupLayoutEntry tableBufferLayout = {};
+    tableBufferLayout.binding = 3;
+    tableBufferLayout.visibility = wgpu::ShaderStage::Compute;
+    tableBufferLayout.buffer.type = wgpu::BufferBindingType::ReadOnlyStorage;
+
+    wgpu::BindGroupLayoutEntry operandBufferLayout = {};
+    operandBufferLayout.binding = 4;
+    operandBufferLayout.visibility = wgpu::ShaderStage::Compute;
+    operandBufferLayout.buffer.type = wgpu::BufferBindingType::ReadOnlyStorage;
+
+    std::vector<wgpu::BindGroupLayoutEntry> entries = {inputBufferLayout, outputBufferLayout, uniformBufferLayout};
+    if (withTable) {
+        entries.push_back(tableBufferLayout);
+    }
+    if (withOperand) {
+        entries.push_back(operandBufferLayout);
+    }
+
+    wgpu::BindGroupLayoutDescriptor layoutDesc = {};
+    layoutDesc.entryCount = entries.size();
+    layoutDesc.entries = entries.data();
+
+    return device.createBindGroupLayout(layoutDesc);
+}
+
+static wgpu::BindGroupLayout createTransformBindGroupLayout(wgpu::Device& device) {
+    return buildTransformBindGroupLayout(device, true, false);
+}
+
+// LAYOUT WITHOUT A TABLE for the tiled transpose
+static wgpu::BindGroupLayout createTransposeBindGroupLayout(wgpu::Device& device) {
+    return buildTransformBindGroupLayout(device, false, false);
+}
+
+static wgpu::BindGroupLayout createFusedTransformBindGroupLayout(wgpu::Device& device) {
+    return buildTransformBindGroupLayout(device, true, true);
+}
+
+static wgpu::BindGroupLayout createFusedTransposeBindGroupLayout(wgpu::Device& device) {
+    return buildTransformBindGroupLayout(device, false, true);
+}
+
+// CREATING BIND GROUP for line transforms, and for transposes when tableBuffer is null;
+// operandBuffer is the fused factor or minuend, null on unfused steps
+static wgpu::BindGroup createTransformBindGroup(
+    wgpu::Device& device,
+    wgpu::BindGroupLayout bindGroupLayout,
+    wgpu::Buffer inputBuffer,
+    uint64_t input_size,
+    wgpu::Buffer outputBuffer,
+    uint64_t output_size,
+    wgpu::Buffer uniformBuffer,
+    size_t uniform_size,
+    wgpu::Buffer tableBuffer,
+    wgpu::Buffer operandBuffer,
+    uint64_t operand_size
+) {
+    wgpu::BindGroupEntry inputEntry = {};
+    inputEntry.binding = 0;
+    inputEntry.buffer = inputBuffer;
+    inputEntry.offset = 0;
+    inputEntry.size = input_size;
+
+    wgpu::BindGroupEntry outputEntry = {};
+    outputEntry.binding = 1;
+    outputEntry.buffer = outputBuffer;
+    outputEntry.offset = 0;
+    outputEntry.size = output_size;
+
+    wgpu::BindGroupEntry uniformEntry = {};
+    uniformEntry.binding = 2;
+    uniformEntry.buffer = uniformBuffer;
+    uniformEntry.offset = 0;
+    uniformEntry.size = uniform_size;
+
+    wgpu::BindGroupEntry tableEntry = {};
+    tableEntry.binding = 3;
+    tableEntry.buffer = tableBuffer;
+    tableEntry.offset = 0;
+    tableEntry.size = tableBuffer ? tableBuffer.getSize() : 0;
+
+    wgpu::BindGroupEntry operandEntry = {};
+    operandEntry.binding = 4;
+    operandEntry.buffer = operandBuffer;
+    operandEntry.offset = 0;
+    operandEntry.size = operand_size;
+
+    std::vector<wgpu::BindGroupEntry> entries = {inputEntry, outputEntry, uniformEntry};
+    if (tableBuffer) {
+        entries.push_back(tableEntry);
+    }
+    if (operandBuffer) {
+        entries.push_back(operandEntry);
+    }
+
+    wgpu::BindGroupDescriptor bindGroupDesc = {};
+    bindGroupDesc.layout = bindGroupLayout;
+    bindGroupDesc.entryCount = entries.size();
+    bindGroupDesc.entries = entries.data();
+
+    return device.createBindGroup(bindGroupDesc);
+}
+
+// CREATING BIND GROUP LAYOUT for the in-place Bluestein filter
+static wgpu::BindGroupLayout createFilterBindGroupLayout(wgpu::Device& device) {
+    wgpu::BindGroupLayoutEntry dataBufferLayout = {};
+    dataBufferLayout.binding = 0;
+    dataBufferLayout.visibility = wgpu::ShaderStage::Compute;
+    dataBufferLayout.buffer.type = wgpu::BufferBindingType::Storage;
+
+    wgpu::BindGroupLayoutEntry uniformBufferLayout = {};
+    uniformBufferLayout.binding = 1;
+    uniformBufferLayout.visibility = wgpu::ShaderStage::Compute;
+    uniformBufferLayout.buffer.type = wgpu::BufferBindingType::Uniform;
+
+    wgpu::BindGroupLayoutEntry spectrumBufferLayout = {};
+    spectrumBufferLayout.binding = 2;
+    spectrumBufferLayout.visibility = wgpu::ShaderStage::Compute;
+    spectrumBufferLayout.buffer.type = wgpu::BufferBindingType::ReadOnlyStorage;
+
+    wgpu::BindGroupLayoutEntry entries[] = {dataBufferLayout, uniformBufferLayout, spectrumBufferLayout};
+
+    wgpu::BindGroupLayoutDescriptor layoutDesc = {};
+    layoutDesc.entryCount = 3;
+    layoutDesc.entries = entries;
+
+    return device.createBindGroupLayout(layoutDesc);
+}
+
+// CREATING BIND GROUP for the Bluestein filter
+static wgpu::BindGroup createFilterBindGroup(
+    wgpu::Device& device,
+    wgpu::BindGroupLayout bindGroupLayout,
+    wgpu::Buffer dataBuffer,
+    wgpu::Buffer uniformBuffer,
+    wgpu::Buffer spectrumBuffer,
+    uint64_t data_size
+) {
+    wgpu::BindGroupEntry dataEntry = {};
+    dataEntry.binding = 0;
+    dataEntry.buffer = dataBuffer;
+    dataEntry.offset = 0;
+    dataEntry.size = data_size;
+
+    wgpu::BindGroupEntry uniformEntry = {};
+    uniformEntry.binding = 1;
+    uniformEntry.buffer = uniformBuffer;
+    uniformEntry.offset = 0;
+    uniformEntry.size = sizeof(uint32_t) * 2;
+
+    wgpu::BindGroupEntry spectrumEntry = {};
+    spectrumEntry.binding = 2;
+    spectrumEntry.buffer = spectrumBuffer;
+    spectrumEntry.offset = 0;
+    spectrumEntry.size = spectrumBuffer.getSize();
+
+    wgpu::BindGroupEntry entries[] = {dataEntry, uniformEntry, spectrumEntry};
+
+    wgpu::BindGroupDescriptor bindGroupDesc = {};
+    bindGroupDesc.layout = bindGroupLayout;
+    bindGroupDesc.entryCount = 3;
+    bindGroupDesc.entries = entries;
+
+    return device.createBindGroup(bindGroupDesc);
+}
+
+// A line fits the shared-memory kernel when both ping-pong halves fit in workgroup memory
+static bool fitsWorkgroupMemory(const WebGPUContext& context, uint32_t n) {
+    return sizeof(float) * 2 * 2 * size_t(n) <= context.capabilities.maxWorkgroupStorageSize;
+}
+
+// Largest n1 <= sqrt(n) dividing n with both n1 and n / n1 fitting in workgroup
+// memory, or 0 when the lines cannot take the six-step route
+static uint32_t sixStepSplit(const WebGPUContext& context, const FFTPlan::LineLayout& layout) {
+    bool packed = layout.elemStride == 1 && layout.lineStride == layout.n && layout.batchStride == 0;
+    if (!packed || layout.lines > context.capabilities.maxWorkgroupsPerDimension) {
+        return 0;
+    }
+    for (uint32_t n1 = uint32_t(std::sqrt(double(layout.n))); n1 > 1; n1--) {
+        if (layout.n % n1 == 0) {
+            uint32_t n2 = layout.n / n1;
+            return fitsWorkgroupMemory(context, n1) && fitsWorkgroupMemory(context, n2) ? n1 : 0;
+        }
+    }
+    return 0;
+}
+
+FFTPlan::FFTPlan(WebGPUContext& context, int rows, int cols, bool inverse, bool inPlace, bool real, FFTNorm norm, FieldStorage inputStorage, FieldStorage outputStorage, FFTFusion fusion)
+    : numRows(rows), numCols(cols), isInverse(inverse), isInPlace(inPlace), isReal(real), normMode(norm),
+      inputStorage(inputStorage), outputStorage(outputStorage), fusion(fusion) {
+    if (rows <= 0 || cols <= 0) {
+        throw std::invalid_argument("FFTPlan requires positive rows and cols");
+    }
+    if (real && inPlace) {
+        throw std::invalid_argument("Real FFT plans change the element type and cannot run in place");
+    }
+    if (real && (inputStorage != FieldStorage::F32 || outputStorage != FieldStorage::F32)) {
+        throw std::invalid_argument("Real FFT plans read and write f32 fields only");
+    }
+    if (inPlace && inputStorage != outputStorage) {
+        throw std::invalid_argument("In-place FFT plans need the same input and output storage");
+    }
+    if (real && (fusion.multiplyInput || fusion.multiplyOutput || fusion.subtractFromMinuend)) {
+        throw std::invalid_argument("Real FFT plans do not fuse elementwise work");
+    }
+    if (fusion.multiplyOutput && fusion.subtractFromMinuend) {
+        throw std::invalid_argument("FFT plans fuse at most one operation into the output write");
+    }
+
+    // Planned for one field (numBatch is 1 until setBatch); record() scales to the batch
+    uint32_t lines = uint32_t(rows);
+    LineLayout rowLayout = {uint32_t(cols), lines, uint32_t(cols), 1, lines, 0};
+
+    // Earlier passes run unscaled; the last one applies the whole 2D normalization
+    float scale = normScale(norm, inverse, size_t(rows) * cols);
+
+    if (!real) {
+        size_t buffer_size = size();
+
+        // Intermediate between the row and column transforms
+        uint32_t work = addTemporary(buffer_size);
+
+        // ==================== ROW FFT ====================
+        planLines(context, work, InputSlot, buffer_size, rowLayout, inverse, 1.0f);
+        rowSteps = {0, steps.size()};
+
+        // ==================== COLUMN FFT ====================
+        planColumns(context, OutputSlot, work, work, rows, cols, inverse, scale);
+        columnSteps = {rowSteps.second, steps.size()};
+        return;
+    }
+
+    // Real plans transform the rows between real and half-spectrum lines and run
+    // the columns on the rows x (cols / 2 + 1) half spectrum only
+    int spectrumCols = cols / 2 + 1;
+    uint32_t spectrum = addTemporary(spectrumSize());
+
+    if (!inverse) {
+        planRealRows(context, spectrum, InputSlot, rowLayout);
+        rowSteps = {0, steps.size()};
+        planColumns(context, OutputSlot, spectrum, spectrum, rows, spectrumCols, false, scale);
+        columnSteps = {rowSteps.second, steps.size()};
+    } else {
+        uint32_t scratch = addTemporary(spectrumSize());
+        planColumns(context, spectrum, InputSlot, scratch, rows, spectrumCols, true, 1.0f);
+        columnSteps = {0, steps.size()};
+        planRealRowsInverse(context, OutputSlot, spectrum, rowLayout, scale);
+        rowSteps = {columnSteps.second, steps.size()};
+    }
+}
+
+void FFTPlan::setBatch(int batch) {
+    if (batch <= 0) {
+        throw std::invalid_argument("FFTPlan requires a positive batch");
+    }
+    numBatch = batch;
+}
+
+FFTPlan::~FFTPlan() {
+    for (Step& step : steps) {
+        if (step.bindGroup) {
+            step.bindGroup.release();
+        }
+    }
+}
+
+// Only the caller's buffers may be stored at reduced precision; temporaries stay f32
+FieldStorage FFTPlan::slotStorage(uint32_t slot) const {
+    if (slot == InputSlot) {
+        return inputStorage;
+    }
+    if (slot == OutputSlot) {
+        return outputStorage;
+    }
+    return FieldStorage::F32;
+}
+
+uint64_t FFTPlan::slotBytes(uint32_t slot, size_t complexLen) const {
+    return fieldBytes(slotStorage(slot), complexLen);
+}
+
+// A fused step reads the factor when it multiplies its input or output and the
+// minuend when it subtracts its output
+uint32_t FFTPlan::operandSlot(uint32_t source, uint32_t target) const {
+    bool multiply = (fusion.multiplyInput && source == InputSlot) || (fusion.multiplyOutput && target == OutputSlot);
+    bool subtract = fusion.subtractFromMinuend && target == OutputSlot;
+    if (multiply && subtract) {
+        throw std::logic_error("FFT plan step cannot fuse both a multiply and a subtraction");
+    }
+    return multiply ? FactorSlot : subtract ? MinuendSlot : NoSlot;
+}
+
+// Fused epilogue and prologue come first: the minuend type is spelled with {{FIELD_OUT}}
+ShaderConstants FFTPlan::slotConstants(uint32_t source, uint32_t target) const {
+    uint32_t operand = operandSlot(source, target);
+    ShaderConstants constants;
+    if (operand == FactorSlot) {
+        constants = {{"FUSED_OPERAND", "@group(0) @binding(4) var<storage, read> operand: array<vec2<f32>>; // factor, one field broadcast over the batch"}};
+        if (fusion.multiplyInput && source == InputSlot) {
+            constants.emplace_back("FUSED_LOAD", "let factor = operand[i % arrayLength(&operand)]; x = vec2<f32>(x.x * factor.x - x.y * factor.y, x.x * factor.y + x.y * factor.x);");
+        }
+        if (fusion.multiplyOutput && target == OutputSlot) {
+            constants.emplace_back("FUSED_STORE", "let factor = operand[i % arrayLength(&operand)]; value = vec2<f32>(value.x * factor.x - value.y * factor.y, value.x * factor.y + value.y * factor.x);");
+        }
+    } else if (operand == MinuendSlot) {
+        constants = {
+            {"FUSED_OPERAND", "@group(0) @binding(4) var<storage, read> operand: array<{{FIELD_OUT}}>; // minuend"},
+            {"FUSED_STORE", "value = vec2<f32>(operand[i]) - value;"},
+        };
+    }
+    for (const char* token : {"FUSED_OPERAND", "FUSED_LOAD", "FUSED_STORE"}) {
+        bool set = std::any_of(constants.begin(), constants.end(), [&](const auto& constant) { return constant.first == token; });
+        if (!set) {
+            constants.emplace_back(token, "");
+        }
+    }
+    ShaderConstants storage = fieldStorageConstants(slotStorage(source), slotStorage(target));
+    constants.insert(constants.end(), storage.begin(), storage.end());
+    return constants;
+}
+
+// Compiles the step's kernel for its slots (storage precision, fused operand) once its
+// source, target and launch are set
+void FFTPlan::setPipeline(WebGPUContext& context, Step& step, const char* shaderFile, bool withTable, const ShaderConstants& extra) {
+    step.operand = operandSlot(step.source, step.target);
+    if (step.operand == FactorSlot) {
+        step.operandBytes = complexBytes(size_t(numRows) * numCols);
+    } else if (step.operand == MinuendSlot) {
+        step.operandBytes = fieldBytes(outputStorage, size());
+    }
+
+    bool fused = step.operand != NoSlot;
+    auto createLayout = withTable
+        ? (fused ? createFusedTransformBindGroupLayout : createTransformBindGroupLayout)
+        : (fused ? createFusedTransposeBindGroupLayout : createTransposeBindGroupLayout);
+    ShaderConstants constants = slotConstants(step.source, step.target);
+    constants.insert(constants.end(), extra.begin(), extra.end());
+    step.cached = getComputePipeline(context, shaderFile, createLayout, step.launch.workgroupSizeX, step.launch.workgroupSizeY, 1, constants);
+}
+
+// Temporaries are only sized here; record() takes them from the buffer pool
+uint32_t FFTPlan::addTemporary(size_t complexLen) {
+    temporaryLens.push_back(complexLen);
+    return FirstTemporarySlot + uint32_t(temporaryLens.size() - 1);
+}
+
+// Column transforms of each rows x cols field; scratch may alias source but not target
+void FFTPlan::planColumns(WebGPUContext& context, uint32_t target, uint32_t source, uint32_t scratch, int rows, int cols, bool inverse, float scale) {
+    size_t buffer_size = size_t(numBatch) * rows * cols;
+    if (cols == 1) {
+        // A single column per field is already contiguous
+        LineLayout colLayout = {uint32_t(rows), uint32_t(numBatch), uint32_t(rows), 1, uint32_t(numBatch), 0};
+        planLines(context, target, source, buffer_size, colLayout, inverse, scale);
+        return;
+    }
+
+    // Strided column reads are uncoalesced, so transpose each field, run the
+    // columns as contiguous lines and transpose back
+    uint32_t transposed = addTemporary(buffer_size);
+    planTranspose(context, transposed, source, uint32_t(rows), uint32_t(cols), uint32_t(numBatch));
+    uint32_t lines = uint32_t(numBatch * cols);
+    LineLayout colLayout = {uint32_t(rows), lines, uint32_t(rows), 1, lines, 0};
+    planLines(context, scratch, transposed, buffer_size, colLayout, inverse, scale);
+    planTranspose(context, target, scratch, uint32_t(cols), uint32_t(rows), uint32_t(numBatch));
+}
+
+// One of the real-FFT packing kernels over every row
+void FFTPlan::planRealKernel(WebGPUContext& context, const char* shaderFile, uint32_t target, uint64_t target_bytes, uint32_t source, uint64_t source_bytes, size_t invocations, wgpu::Buffer table) {
+    Step step;
+    step.kind = table ? StepKind::Transform : StepKind::Transpose;
+    step.launch = linearLaunch(context, invocations);
+    step.launchCount = invocations;
+    step.cached = getComputePipeline(context, shaderFile, table ? createTransformBindGroupLayout : createTransposeBindGroupLayout, step.launch.workgroupSizeX);
+
+    RealParams params = {uint32_t(numCols), uint32_t(numBatch * numRows), 0, 0};
+    setStepParams(step, params, {1});
+    step.table = table;
+
+    step.source = source;
+    step.sourceBytes = source_bytes;
+    step.target = target;
+    step.targetBytes = target_bytes;
+    steps.push_back(std::move(step));
+}
+
+// Real rows -> half-spectrum rows. Even rows are read as n/2 complex pairs and
+// split after a half-length transform; odd rows take a full complex transform.
+void FFTPlan::planRealRows(WebGPUContext& context, uint32_t target, uint32_t source, const LineLayout& rows) {
+    uint64_t real_bytes = sizeof(float) * size();
+    size_t spectrum_size = spectrumSize();
+
+    if (rows.n % 2 == 0) {
+        uint32_t half = rows.n / 2;
+        size_t packed_size = size_t(rows.lines) * half;
+        uint32_t packed = addTemporary(packed_size);
+        LineLayout halfRows = {half, rows.lines, half, 1, rows.lines, 0};
+        planLines(context, packed, source, packed_size, halfRows, false, 1.0f);
+        planRealKernel(context, "src/common/fft/fft_rfft_split.wgsl", target, complexBytes(spectrum_size), packed, complexBytes(packed_size), spectrum_size, getTwiddleTable(context, rows.n, false));
+        return;
+    }
+
+    size_t buffer_size = size();
+    uint32_t promoted = addTemporary(buffer_size);
+    uint32_t transformed = addTemporary(buffer_size);
+    planRealKernel(context, "src/common/fft/fft_real_promote.wgsl", promoted, complexBytes(buffer_size), source, real_bytes, buffer_size);
+    planLines(context, transformed, promoted, buffer_size, rows, false, 1.0f);
+    planRealKernel(context, "src/common/fft/fft_real_crop.wgsl", target, complexBytes(spectrum_size), transformed, complexBytes(buffer_size), spectrum_size);
+}
+
+// Half-spectrum rows -> real rows, the inverse of planRealRows; scale is relative to the unnormalized inverse
+void FFTPlan::planRealRowsInverse(WebGPUContext& context, uint32_t target, uint32_t source, const LineLayout& rows, float scale) {
+    uint64_t real_bytes = sizeof(float) * size();
+    size_t spectrum_size = spectrumSize();
+
+    if (rows.n % 2 == 0) {
+        // the half-length inverse of the merged spectrum is the real row itself; the merge
+        // halves its inputs, so the unnormalized row needs twice the scale
+        uint32_t half = rows.n / 2;
+        size_t packed_size = size_t(rows.lines) * half;
+        uint32_t packed = addTemporary(packed_size);
+        planRealKernel(context, "src/common/fft/fft_irfft_merge.wgsl", packed, complexBytes(packed_size), source, complexBytes(spectrum_size), packed_size, getTwiddleTable(context, rows.n, true));
+        LineLayout halfRows = {half, rows.lines, half, 1, rows.lines, 0};
+        planLines(context, target, packed, packed_size, halfRows, true, 2.0f * scale);
+        return;
+    }
+
+    size_t buffer_size = size();
+    uint32_t extended = addTemporary(buffer_size);
+    uint32_t transformed = addTemporary(buffer_size);
+    planRealKernel(context, "src/common/fft/fft_real_extend.wgsl", extended, complexBytes(buffer_size), source, complexBytes(spectrum_size), buffer_size);
+    planLines(context, transformed, extended, buffer_size, rows, true, scale);
+    planRealKernel(context, "src/common/fft/fft_real_part.wgsl", target, real_bytes, transformed, complexBytes(buffer_size), buffer_size);
+}
+
+// Transposes each of the rows x cols fields from source into target. With a twiddle
+// table, element (row, col) is also multiplied by entry row * col (six-step middle pass).
+void FFTPlan::planTranspose(WebGPUContext& context, uint32_t target, uint32_t source, uint32_t rows, uint32_t cols, uint32_t fields, wgpu::Buffer table) {
+    size_t buffer_size = size_t(fields) * rows * cols;
+
+    Step step;
+    step.kind = table ? StepKind::Transform : StepKind::Transpose;
+    step.launch = gridLaunch(context, cols, rows);
+    step.launchKind = LaunchKind::Grid;
+    step.launchCount = fields;
+    step.table = table;
+
+    TransposeParams params = {rows, cols, fields, 0};
+    setStepParams(step, params, {2});
+
+    step.source = source;
+    step.sourceBytes = slotBytes(source, buffer_size);
+    step.target = target;
+    step.targetBytes = slotBytes(target, buffer_size);
+    setPipeline(context, step, table ? "src/common/fft/fft_four_step_twiddle.wgsl" : "src/common/fft/fft_transpose.wgsl", bool(table));
+    steps.push_back(std::move(step));
+}
+
+// Transforms every line of the layout from source into target, multiplied by scale on the last write
+void FFTPlan::planLines(WebGPUContext& context, uint32_t target, uint32_t source, size_t buffer_size, const LineLayout& layout, bool inverse, float scale) {
+    std::vector<uint32_t> radices;
+    if (!factorRadices(layout.n, radices, context.tuning.fftRadix4)) {
+        planBluestein(context, target, source, buffer_size, layout, inverse, scale);
+    } else if (fitsWorkgroupMemory(context, layout.n)) {
+        planShared(context, target, source, buffer_size, layout, radices, inverse, scale);
+    } else if (uint32_t split = sixStepSplit(context, layout)) {
+        planSixStep(context, target, source, buffer_size, layout, split, inverse, scale);
+    } else {
+        planGlobal(context, target, source, buffer_size, layout, radices, inverse, scale);
+    }
+}
+
+// Six-step FFT for lines too long for workgroup memory: each line is an n1 x n2 matrix,
+// and both sub-transforms run as contiguous shared-memory lines between tiled transposes
+void FFTPlan::planSixStep(WebGPUContext& context, uint32_t target, uint32_t source, size_t buffer_size, const LineLayout& layout, uint32_t n1, bool inverse, float scale) {
+    uint32_t n2 = layout.n / n1;
+    uint32_t scratchA = sharedScratch(0, buffer_size);
+    uint32_t scratchB = sharedScratch(1, buffer_size);
+
+    // x[j1 * n2 + j2] -> columns j2 as contiguous length-n1 lines, transformed over j1
+    planTranspose(context, scratchA, source, n1, n2, layout.lines);
+    LineLayout firstLines = {n1, layout.lines * n2, n1, 1, layout.lines * n2, 0};
+    planLines(context, scratchB, scratchA, buffer_size, firstLines, inverse, 1.0f);
+
+    // twiddle W_n^(j2 * k1) on the way back to k1-major lines, then transform over j2
+    planTranspose(context, scratchA, scratchB, n2, n1, layout.lines, getTwiddleTable(context, layout.n, inverse));
+    LineLayout secondLines = {n2, layout.lines * n1, n2, 1, layout.lines * n1, 0};
+    planLines(context, scratchB, scratchA, buffer_size, secondLines, inverse, scale);
+
+    // X[k1 + n1 * k2] sits at (k1, k2); one more transpose gives natural order
+    planTranspose(context, target, scratchB, n1, n2, layout.lines);
+}
+
+// Scratch slot reused by every six-step pass of the plan, grown to the largest request.
+// Like every temporary it comes from the context's pool at record time, so the
+// six-step scratch of all plans shares the same pooled buffers.
+uint32_t FFTPlan::sharedScratch(size_t index, size_t complexLen) {
+    if (index == scratchSlots.size()) {
+        scratchSlots.push_back(addTemporary(complexLen));
+    }
+    size_t& len = temporaryLens[scratchSlots[index] - FirstTemporarySlot];
+    len = std::max(len, complexLen);
+    return scratchSlots[index];
+}
+
+// All stages of every line in one dispatch, one workgroup per line
+void FFTPlan::planShared(WebGPUContext& context, uint32_t target, uint32_t source, size_t buffer_size, const LineLayout& layout, const std::vector<uint32_t>& radices, bool inverse, float scale) {
+    Step step;
+
+    // One thread per butterfly of the smallest radix, looping past the workgroup limits
+    uint32_t minRadix = radices.empty() ? 1 : *std::min_element(radices.begin(), radices.end());
+    uint32_t threads = std::max(1u, layout.n / minRadix);
+    if (context.tuning.fftThreadsPerLine) {
+        threads = std::min(threads, context.tuning.fftThreadsPerLine);
+    }
+    step.launch = groupLaunch(context, layout.lines, threads);
+    step.launchKind = LaunchKind::Groups;
+    step.launchCount = layout.lines;
+
+    StockhamParams params = {};
+    params.stages = uint32_t(radices.size());
+    params.lines = layout.lines;
+    params.lineStride = layout.lineStride;
+    params.elemStride = layout.elemStride;
+    params.scale = scale;
+    params.linesPerBatch = layout.linesPerBatch;
+    params.batchStride = layout.batchStride;
+    std::copy(radices.begin(), radices.end(), params.radices);
+    setStepParams(step, params, {1, 5});
+    step.table = getTwiddleTable(context, layout.n, inverse);
+
+    step.source = source;
+    step.sourceBytes = slotBytes(source, buffer_size);
+    step.target = target;
+    step.targetBytes = slotBytes(target, buffer_size);
+    setPipeline(context, step, "src/common/fft/fft_stockham.wgsl", true, {{"FFT_LENGTH", std::to_string(layout.n)}});
+    steps.push_back(std::move(step));
+}
+
+// One dispatch per stage through global memory, for lines too long for workgroup memory
+void FFTPlan::planGlobal(WebGPUContext& context, uint32_t target, uint32_t source, size_t buffer_size, const LineLayout& layout, const std::vector<uint32_t>& radices, bool inverse, float scale) {
+    // Intermediate stages ping-pong between two temporaries; the last stage writes the target
+    uint32_t ping = radices.size() > 1 ? addTemporary(buffer_size) : target;
+    uint32_t pong = radices.size() > 2 ? addTemporary(buffer_size) : target;
+
+    uint32_t src = source;
+    uint32_t span = 1;
+    for (size_t stage = 0; stage < radices.size(); stage++) {
+        bool last = stage + 1 == radices.size();
+        uint32_t dst = last ? target : (stage % 2 == 0 ? ping : pong);
+        uint32_t radix = radices[stage];
+
+        Step step;
+        step.launchCount = size_t(layout.lines) * (layout.n / radix);
+        step.launch = linearLaunch(context, step.launchCount);
+
+        StageParams params = {
+            layout.n,
+            layout.lines,
+            layout.lineStride,
+            layout.elemStride,
+            radix,
+            span,
+            last ? scale : 1.0f,
+            layout.linesPerBatch,
+            layout.batchStride,
+            0, 0, 0
+        };
+        setStepParams(step, params, {1, 7});
+        step.table = getTwiddleTable(context, layout.n, inverse);
+
+        step.source = src;
+        step.sourceBytes = slotBytes(src, buffer_size);
+        step.target = dst;
+        step.targetBytes = slotBytes(dst, buffer_size);
+        setPipeline(context, step, "src/common/fft/fft_stockham_stage.wgsl", true);
+        steps.push_back(std::move(step));
+
+        src = dst;
+        span *= radix;
+    }
+}
+
+// Bluestein / chirp-z: an arbitrary length-n transform as a power-of-2 length-m convolution
+void FFTPlan::planBluestein(WebGPUContext& context, uint32_t target, uint32_t source, size_t buffer_size, const LineLayout& layout, bool inverse, float scale) {
+    uint32_t m = nextPowerOf2(2 * layout.n - 1);
+    size_t padded_size = size_t(layout.lines) * m;
+    uint32_t padded = addTemporary(padded_size);
+    uint32_t spectral = addTemporary(padded_size);
+
+    wgpu::Buffer chirpBuffer = getChirpTable(context, layout.n, inverse);
+    BluesteinParams params = {layout.n, m, layout.lines, layout.lineStride, layout.elemStride, scale, layout.linesPerBatch, layout.batchStride};
+
+    // a[k] = x[k] * chirp[k], zero-padded to m
+    {
+        Step step;
+        step.launch = linearLaunch(context, padded_size);
+        step.launchCount = padded_size;
+        setStepParams(step, params, {2, 6});
+        step.table = chirpBuffer;
+        step.source = source;
+        step.sourceBytes = slotBytes(source, buffer_size);
+        step.target = padded;
+        step.targetBytes = complexBytes(padded_size);
+        setPipeline(context, step, "src/common/fft/fft_bluestein_chirp.wgsl", true);
+        steps.push_back(std::move(step));
+    }
+
+    // Convolve with conj(chirp): forward FFT, filter, normalized inverse FFT
+    LineLayout packed = {m, layout.lines, m, 1, layout.lines, 0};
+    planLines(context, spectral, padded, padded_size, packed, false, 1.0f);
+    {
+        uint32_t filterParams[2] = {m, layout.lines};
+
+        Step step;
+        step.launch = linearLaunch(context, padded_size);
+        step.launchCount = padded_size;
+        step.cached = getComputePipeline(context, "src/common/fft/fft_bluestein_filter.wgsl", createFilterBindGroupLayout, step.launch.workgroupSizeX);
+        setStepParams(step, filterParams, {1});
+        step.table = getBluesteinSpectrum(context, layout.n, m, inverse);
+        step.kind = StepKind::Filter;
+        step.source = spectral;
+        step.sourceBytes = complexBytes(padded_size);
+        step.target = spectral;
+        step.targetBytes = complexBytes(padded_size);
+        steps.push_back(std::move(step));
+    }
+    planLines(context, padded, spectral, padded_size, packed, true, 1.0f / float(m));
+
+    // X[k] = scale * chirp[k] * conv[k]
+    {
+        Step step;
+        step.launchCount = size_t(layout.lines) * layout.n;
+        step.launch = linearLaunch(context, step.launchCount);
+        setStepParams(step, params, {2, 6});
+        step.table = chirpBuffer;
+        step.source = padded;
+        step.sourceBytes = complexBytes(padded_size);
+        step.target = target;
+        step.targetBytes = slotBytes(target, buffer_size);
+        setPipeline(context, step, "src/common/fft/fft_bluestein_post.wgsl", true);
+        steps.push_back(std::move(step));
+    }
+}
+
+void FFTPlan::execute(WebGPUContext& context, wgpu::Buffer& outputBuffer, wgpu::Buffer& inputBuffer) {
+    record(context, outputBuffer, inputBuffer, nullptr, nullptr, Pass::All);
+}
+
+void FFTPlan::execute(WebGPUContext& context, wgpu::Buffer& outputBuffer, wgpu::Buffer& inputBuffer, Pass pass) {
+    record(context, outputBuffer, inputBuffer, nullptr, nullptr, pass);
+}
+
+void FFTPlan::execute(WebGPUContext& context, wgpu::Buffer& outputBuffer, wgpu::Buffer& inputBuffer, wgpu::Buffer& factorBuffer, wgpu::Buffer& minuendBuffer) {
+    record(context, outputBuffer, inputBuffer, factorBuffer, minuendBuffer, Pass::All);
+}
+
+void FFTPlan::record(WebGPUContext& context, wgpu::Buffer outputBuffer, wgpu::Buffer inputBuffer, wgpu::Buffer factorBuffer, wgpu::Buffer minuendBuffer, Pass pass) {
+    if (isInPlace && outputBuffer != inputBuffer) {
+        throw std::invalid_argument("In-place FFTPlan requires the output buffer to alias the input");
+    }
+    if (((fusion.multiplyInput || fusion.multiplyOutput) && !factorBuffer) || (fusion.subtractFromMinuend && !minuendBuffer)) {
+        throw std::invalid_argument("Fused FFTPlan requires its factor and minuend buffers");
+    }
+    if (fusion.subtractFromMinuend && minuendBuffer == outputBuffer) {
+        throw std::invalid_argument("Fused FFTPlan cannot subtract from its own output buffer");
+    }
+
+    uint32_t batch = uint32_t(numBatch);
+
+    // WebGPU would only reject an oversized binding inside validation, with no hint of the transform
+    uint64_t bindingLimit = context.capabilities.maxStorageBufferBindingSize;
+    auto checkBinding = [&](uint64_t bytes) {
+        if (bytes > bindingLimit) {
+            throw std::runtime_error("FFT of " + std::to_string(numBatch) + " x " + std::to_string(numRows) + " x " + std::to_string(numCols)
+                + " fields binds " + std::to_string(bytes) + " bytes, over the device's maxStorageBufferBindingSize of "
+                + std::to_string(bindingLimit) + "; transform fewer fields at a time");
+        }
+    };
+
+    for (size_t len : temporaryLens) {
+        checkBinding(complexBytes(len * batch));
+    }
+
+    // Temporaries come from the pool for this recording only; once they go out of
+    // scope the pool holds them back until the stream is submitted
+    std::vector<PooledBuffer> temporaries(temporaryLens.size());
+
+    wgpu::Device device = context.device;
+    auto resolve = [&](uint32_t slot) -> wgpu::Buffer {
+        switch (slot) {
+        case NoSlot:
+            return nullptr;
+        case InputSlot:
+            return inputBuffer;
+        case OutputSlot:
+            return outputBuffer;
+        case FactorSlot:
+            return factorBuffer;
+        case MinuendSlot:
+            return minuendBuffer;
+        default: {
+            PooledBuffer& temporary = temporaries[slot - FirstTemporarySlot];
+            if (!temporary) {
+                temporary = acquireBuffer(context, nullptr, complexBytes(temporaryLens[slot - FirstTemporarySlot] * batch));
+            }
+            return temporary.get();
+        }
+        }
+    };
+
+    size_t first = 0;
+    size_t last = steps.size();
+    if (pass != Pass::All) {
+        const std::pair<size_t, size_t>& range = pass == Pass::Rows ? rowSteps : columnSteps;
+        first = range.first;
+        last = range.second;
+    }
+    for (size_t i = first; i < last; i++) {
+        Step& step = steps[i];
+        wgpu::Buffer source = resolve(step.source);
+        wgpu::Buffer target = resolve(step.target);
+        wgpu::Buffer operand = resolve(step.operand);
+
+        // Lines and fields of the uniform count the whole batch
+        if (step.paramsBatch != batch) {
+            std::vector<uint32_t> words = step.paramsWords;
+            for (size_t word : step.batchedWords) {
+                words[word] *= batch;
+            }
+            step.params = acquireBuffer(context, words.data(), step.paramsSize, wgpu::BufferUsage::Uniform);
+            step.paramsBatch = batch;
+        }
+
+        // Bind groups are rebuilt only when the batch, the caller's buffers or the pooled temporaries change
+        if (!step.bindGroup || batch != step.boundBatch || source != step.boundSource || target != step.boundTarget || operand != step.boundOperand) {
+            if (step.bindGroup) {
+                step.bindGroup.release();
+            }
+            // The factor is one field broadcast over the batch; everything else scales
+            uint64_t operandBytes = step.operand == FactorSlot ? step.operandBytes : step.operandBytes * batch;
+            checkBinding(step.sourceBytes * batch);
+            checkBinding(step.targetBytes * batch);
+            checkBinding(operandBytes);
+            if (step.kind == StepKind::Filter) {
+                step.bindGroup = createFilterBindGroup(device, step.cached.bindGroupLayout, target, step.params, step.table, step.targetBytes * batch);
+            } else {
+                step.bindGroup = createTransformBindGroup(device, step.cached.bindGroupLayout, source, step.sourceBytes * batch, target, step.targetBytes * batch, step.params, step.paramsSize, step.table, operand, operandBytes);
+            }
+            step.boundSource = source;
+            step.boundTarget = target;
+            step.boundOperand = operand;
+            step.boundBatch = batch;
+        }
+
+        // The stream releases what it records, so hand it a reference of its own
+        step.bindGroup.reference();
+        dispatchCompute(context, step.cached.pipeline, step.bindGroup, batchLaunch(context, step, batch));
+    }
+}
+
+void FFTPlan::execute(WebGPUContext& context, wgpu::Buffer& buffer) {
+    execute(context, buffer, buffer);
+}
+
+static const char* normName(FFTNorm norm) {
+    switch (norm) {
+    case FFTNorm::None:
+        return "|none";
+    case FFTNorm::Forward:
+        return "|forward-norm";
+    case FFTNorm::Ortho:
+        return "|ortho";
+    default:
+        return "|backward-norm";
+    }
+}
+
+static const char* storageName(FieldStorage storage) {
+    return storage == FieldStorage::F16 ? "f16" : "f32";
+}
+
+// The batch is not part of the key: it only scales the plan's uniforms and launches
+static FFTPlan& findFFTPlan(WebGPUContext& context, int rows, int cols, int batch, bool inverse, bool inPlace, bool real, FFTNorm norm, FieldStorage inputStorage, FieldStorage outputStorage, FFTFusion fusion) {
+    std::string key = std::to_string(rows) + "x" + std::to_string(cols)
+        + (inverse ? "|inverse" : "|forward") + (inPlace ? "|in-place" : "|out-of-place") + (real ? "|real" : "|complex") + normName(norm)
+        + "|" + storageName(inputStorage) + "->" + storageName(outputStorage)
+        + (fusion.multiplyInput ? "|multiply" : "") + (fusion.multiplyOutput ? "|multiply-output" : "")
+        + (fusion.subtractFromMinuend ? "|subtract" : "");
+
+    auto it = context.fftPlans.find(key);
+    if (it == context.fftPlans.end()) {
+        it = context.fftPlans.emplace(key, std::make_shared<FFTPlan>(context, rows, cols, inverse, inPlace, real, norm, inputStorage, outputStorage, fusion)).first;
+    }
+    it->second->setBatch(batch);
+    return *it->second;
+}
+
+FFTPlan& getFFTPlan(WebGPUContext& context, int rows, int cols, int batch, bool inverse, bool inPlace, FFTNorm norm, FieldStorage inputStorage, FieldStorage outputStorage, FFTFusion fusion) {
+    return findFFTPlan(context, rows, cols, batch, inverse, inPlace, false, norm, inputStorage, outputStorage, fusion);
+}
+
+FFTPlan& getRealFFTPlan(WebGPUContext& context, int rows, int cols, int batch, bool inverse, FFTNorm norm) {
+    return findFFTPlan(context, rows, cols, batch, inverse, false, true, norm, FieldStorage::F32, FieldStorage::F32, FFTFusion());
+}
+
+void releaseFFTPlans(WebGPUContext& context) {
+    flushStream(context);
+    context.fftPlans.clear();
+}
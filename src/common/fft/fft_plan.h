@@ -0,0 +1,110 @@
+#ifndef FFT_PLAN_H
+#define FFT_PLAN_H
+
+#include <webgpu/webgpu.hpp>
+#include "../webgpu_utils.h"
+#include "fft_utils.h"
+#include <utility>
+#include <vector>
+
+// Elementwise work folded into a plan's first read and last write, so it costs no pass of its own
+struct FFTFusion {
+    bool multiplyInput = false;       // transform input * factor; factor is one rows x cols field for the whole batch
+    bool multiplyOutput = false;      // output = transform * factor, with the same factor
+    bool subtractFromMinuend = false; // output = minuend - transform; minuend has the output's layout and storage
+};
+
+// Pre-built 2D FFT over batch x rows x cols contiguous fields, for one direction and
+// placement. The plan is built for one field and scales its uniforms, launches and
+// bindings to the batch set by setBatch() when it records, so one plan serves every
+// batch size. Real plans map real fields to their rows x (cols / 2 + 1) half spectra
+// (forward) or back (inverse); complex plans may read and write f16 fields (see
+// FieldStorage) while their temporaries stay f32. The normalization is applied once,
+// on the write of the last pass. The plan owns its uniforms and bind groups and
+// references cached pipelines and twiddle tables; its f32 temporaries are taken from
+// the context's buffer pool on each execute() and returned with the stream, so idle
+// plans pin no scratch memory. Bind groups are rebuilt only when the buffers they
+// touch change.
+class FFTPlan {
+public:
+    // Row and column passes; columns run as tiled transpose, contiguous lines, transpose back
+    enum class Pass { All, Rows, Columns };
+
+    FFTPlan(WebGPUContext& context, int rows, int cols, bool inverse, bool inPlace, bool real = false, FFTNorm norm = FFTNorm::Backward,
+            FieldStorage inputStorage = FieldStorage::F32, FieldStorage outputStorage = FieldStorage::F32, FFTFusion fusion = FFTFusion());
+    ~FFTPlan();
+
+    // Number of fields the next execute() transforms
+    void setBatch(int batch);
+
+    FFTPlan(const FFTPlan&) = delete;
+    FFTPlan& operator=(const FFTPlan&) = delete;
+
+    void execute(WebGPUContext& context, wgpu::Buffer& outputBuffer, wgpu::Buffer& inputBuffer);
+    // In-place plans transform the buffer onto itself
+    void execute(WebGPUContext& context, wgpu::Buffer& buffer);
+    // Records a single pass, for profiling; temporaries are not kept between the two passes
+    void execute(WebGPUContext& context, wgpu::Buffer& outputBuffer, wgpu::Buffer& inputBuffer, Pass pass);
+    // Fused plans also bind the factor and minuend of their FFTFusion
+    void execute(WebGPUContext& context, wgpu::Buffer& outputBuffer, wgpu::Buffer& inputBuffer, wgpu::Buffer& factorBuffer, wgpu::Buffer& minuendBuffer);
+
+    int rows() const { return numRows; }
+    int cols() const { return numCols; }
+    int batch() const { return numBatch; }
+    bool inverse() const { return isInverse; }
+    bool inPlace() const { return isInPlace; }
+    bool real() const { return isReal; }
+    FFTNorm norm() const { return normMode; }
+    size_t size() const { return size_t(numBatch) * numRows * numCols; }
+    // Complex elements of the half spectra a real plan reads or writes
+    size_t spectrumSize() const { return size_t(numBatch) * numRows * (numCols / 2 + 1); }
+
+    struct Step;
+    struct LineLayout;
+
+private:
+    FieldStorage slotStorage(uint32_t slot) const;
+    uint64_t slotBytes(uint32_t slot, size_t complexLen) const;
+    uint32_t operandSlot(uint32_t source, uint32_t target) const;
+    ShaderConstants slotConstants(uint32_t source, uint32_t target) const;
+    void setPipeline(WebGPUContext& context, Step& step, const char* shaderFile, bool withTable, const ShaderConstants& extra = {});
+    void record(WebGPUContext& context, wgpu::Buffer outputBuffer, wgpu::Buffer inputBuffer, wgpu::Buffer factorBuffer, wgpu::Buffer minuendBuffer, Pass pass);
+    uint32_t addTemporary(size_t complexLen);
+    void planColumns(WebGPUContext& context, uint32_t target, uint32_t source, uint32_t scratch, int rows, int cols, bool inverse, float scale);
+    void planRealKernel(WebGPUContext& context, const char* shaderFile, uint32_t target, uint64_t target_bytes, uint32_t source, uint64_t source_bytes, size_t invocations, wgpu::Buffer table = nullptr);
+    void planRealRows(WebGPUContext& context, uint32_t target, uint32_t source, const LineLayout& rows);
+    void planRealRowsInverse(WebGPUContext& context, uint32_t target, uint32_t source, const LineLayout& rows, float scale);
+    void planTranspose(WebGPUContext& context, uint32_t target, uint32_t source, uint32_t rows, uint32_t cols, uint32_t fields, wgpu::Buffer table = nullptr);
+    void planSixStep(WebGPUContext& context, uint32_t target, uint32_t source, size_t buffer_size, const LineLayout& layout, uint32_t n1, bool inverse, float scale);
+    uint32_t sharedScratch(size_t index, size_t complexLen);
+    void planLines(WebGPUContext& context, uint32_t target, uint32_t source, size_t buffer_size, const LineLayout& layout, bool inverse, float scale);
+    void planShared(WebGPUContext& context, uint32_t target, uint32_t source, size_t buffer_size, const LineLayout& layout, const std::vector<uint32_t>& radices, bool inverse, float scale);
+    void planGlobal(WebGPUContext& context, uint32_t target, uint32_t source, size_t buffer_size, const LineLayout& layout, const std::vector<uint32_t>& radices, bool inverse, float scale);
+    void planBluestein(WebGPUContext& context, uint32_t target, uint32_t source, size_t buffer_size, const LineLayout& layout, bool inverse, float scale);
+
+    int numRows = 0;
+    int numCols = 0;
+    int numBatch = 1;
+    bool isInverse = false;
+    bool isInPlace = false;
+    bool isReal = false;
+    FFTNorm normMode = FFTNorm::Backward;
+    FieldStorage inputStorage = FieldStorage::F32;
+    FieldStorage outputStorage = FieldStorage::F32;
+    FFTFusion fusion;
+
+    std::vector<size_t> temporaryLens; // complex elements of each temporary slot
+    std::vector<Step> steps;
+    std::vector<uint32_t> scratchSlots;
+    // [first, last) step indices of each pass; inverse real plans run the columns first
+    std::pair<size_t, size_t> rowSteps;
+    std::pair<size_t, size_t> columnSteps;
+};
+
+// Returns the context's cached plan for this shape, building it on first use, set to batch fields
+FFTPlan& getFFTPlan(WebGPUContext& context, int rows, int cols, int batch, bool inverse, bool inPlace = false, FFTNorm norm = FFTNorm::Backward,
+                   FieldStorage inputStorage = FieldStorage::F32, FieldStorage outputStorage = FieldStorage::F32, FFTFusion fusion = FFTFusion());
+FFTPlan& getRealFFTPlan(WebGPUContext& context, int rows, int cols, int batch, bool inverse, FFTNorm norm = FFTNorm::Backward);
+void releaseFFTPlans(WebGPUContext& context);
+
+#endif // FFT_PLAN_H
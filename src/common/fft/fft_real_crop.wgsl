@@ -0,0 +1,22 @@
+struct RealParams {
+    n: u32,     // real line length
+    lines: u32, // number of lines (rows of every batch member)
+    pad0: u32,
+    pad1: u32,
+}
+
+@group(0) @binding(0) var<storage, read> input: array<vec2<f32>>;      // lines x n full spectrum
+@group(0) @binding(1) var<storage, read_write> output: array<vec2<f32>>; // lines x (n/2 + 1) half spectrum
+@group(0) @binding(2) var<uniform> params: RealParams;
+
+// Odd n: keeps the non-redundant half of each Hermitian spectrum
+@compute @workgroup_size({{WORKGROUP_SIZE}})
+fn main(@builtin(global_invocation_id) global_id: vec3<u32>, @builtin(num_workgroups) num_groups: vec3<u32>) {
+    let idx = global_id.x + global_id.y * num_groups.x * {{WORKGROUP_SIZE_X}}u;
+    let half_len = params.n / 2u + 1u;
+    if (idx >= params.lines * half_len) {
+        return;
+    }
+
+    output[idx] = input[(idx / half_len) * params.n + idx % half_len];
+}
@@ -0,0 +1,21 @@
+struct RealParams {
+    n: u32,     // real line length
+    lines: u32, // number of lines (rows of every batch member)
+    pad0: u32,
+    pad1: u32,
+}
+
+@group(0) @binding(0) var<storage, read> input: array<vec2<f32>>; // lines x n complex
+@group(0) @binding(1) var<storage, read_write> output: array<f32>;  // lines x n real
+@group(0) @binding(2) var<uniform> params: RealParams;
+
+// Odd n: the inverse of a Hermitian spectrum is real up to rounding
+@compute @workgroup_size({{WORKGROUP_SIZE}})
+fn main(@builtin(global_invocation_id) global_id: vec3<u32>, @builtin(num_workgroups) num_groups: vec3<u32>) {
+    let idx = global_id.x + global_id.y * num_groups.x * {{WORKGROUP_SIZE_X}}u;
+    if (idx >= params.lines * params.n) {
+        return;
+    }
+
+    output[idx] = input[idx].x;
+}
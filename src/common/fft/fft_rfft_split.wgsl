@@ -0,0 +1,39 @@
+struct RealParams {
+    n: u32,     // real line length
+    lines: u32, // number of lines (rows of every batch member)
+    pad0: u32,
+    pad1: u32,
+}
+
+@group(0) @binding(0) var<storage, read> input: array<vec2<f32>>;      // lines x n/2, FFT of the packed pairs
+@group(0) @binding(1) var<storage, read_write> output: array<vec2<f32>>; // lines x (n/2 + 1) half spectrum
+@group(0) @binding(2) var<uniform> params: RealParams;
+@group(0) @binding(3) var<storage, read> twiddles: array<vec2<f32>>; // n forward entries
+
+fn complex_mul(a: vec2<f32>, b: vec2<f32>) -> vec2<f32> {
+    return vec2<f32>(a.x * b.x - a.y * b.y, a.x * b.y + a.y * b.x);
+}
+
+// Even n: the real line was transformed as n/2 complex values z[j] = x[2j] + i x[2j+1].
+// With E and O the spectra of the even and odd samples,
+// E[k] = (Z[k] + conj(Z[h-k])) / 2, O[k] = (Z[k] - conj(Z[h-k])) / 2i and X[k] = E[k] + W^k O[k].
+@compute @workgroup_size({{WORKGROUP_SIZE}})
+fn main(@builtin(global_invocation_id) global_id: vec3<u32>, @builtin(num_workgroups) num_groups: vec3<u32>) {
+    let idx = global_id.x + global_id.y * num_groups.x * {{WORKGROUP_SIZE_X}}u;
+    let h = params.n / 2u;
+    if (idx >= params.lines * (h + 1u)) {
+        return;
+    }
+
+    let line = idx / (h + 1u);
+    let k = idx % (h + 1u);
+    let z = input[line * h + k % h];
+    let zc = input[line * h + (h - k) % h];
+    let zc_conj = vec2<f32>(zc.x, -zc.y);
+
+    let even = 0.5 * (z + zc_conj);
+    let d = z - zc_conj;
+    let odd = 0.5 * vec2<f32>(d.y, -d.x); // d / 2i
+
+    output[idx] = even + complex_mul(twiddles[k], odd);
+}
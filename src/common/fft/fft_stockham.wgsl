@@ -0,0 +1,104 @@
+{{ENABLE_F16}}
+
+struct StockhamParams {
+    stages: u32,
+    lines: u32,       // number of independent transforms
+    line_stride: u32, // distance between the first elements of consecutive lines
+    elem_stride: u32, // distance between consecutive elements of one line
+    scale: f32,       // applied on the final write (normalization)
+    lines_per_batch: u32, // lines of one batch member
+    batch_stride: u32,    // distance between consecutive batch members
+    pad0: u32,
+    radices: array<vec4<u32>, 8>, // radix of stage s at radices[s / 4][s % 4], each 2, 3, 4, 5 or 7
+}
+
+@group(0) @binding(0) var<storage, read> input: array<{{FIELD_IN}}>;
+@group(0) @binding(1) var<storage, read_write> output: array<{{FIELD_OUT}}>;
+@group(0) @binding(2) var<uniform> params: StockhamParams;
+@group(0) @binding(3) var<storage, read> twiddles: array<vec2<f32>>; // FFT_LENGTH entries for this direction
+{{FUSED_OPERAND}}
+
+const FFT_LENGTH: u32 = {{FFT_LENGTH}}u;
+const THREADS: u32 = {{WORKGROUP_SIZE_X}}u;
+
+// Ping-pong halves for the out-of-place Stockham stages
+var<workgroup> scratch: array<vec2<f32>, 2 * {{FFT_LENGTH}}>;
+
+fn complex_mul(a: vec2<f32>, b: vec2<f32>) -> vec2<f32> {
+    return vec2<f32>(a.x * b.x - a.y * b.y, a.x * b.y + a.y * b.x);
+}
+
+// Input element i, times the factor when the plan fuses a multiply into its first read
+fn load_input(i: u32) -> vec2<f32> {
+    var x = vec2<f32>(input[i]);
+    {{FUSED_LOAD}}
+    return x;
+}
+
+// Writes output element i, subtracted from the minuend when the plan fuses one into its last write
+fn store_output(i: u32, result: vec2<f32>) {
+    var value = result;
+    {{FUSED_STORE}}
+    output[i] = {{FIELD_OUT}}(value);
+}
+
+// One workgroup transforms one line entirely in workgroup memory:
+// a single global read, one mixed-radix Stockham stage per factor, a single global write.
+@compute @workgroup_size({{WORKGROUP_SIZE}})
+fn main(
+    @builtin(local_invocation_id) local_id: vec3<u32>,
+    @builtin(workgroup_id) group_id: vec3<u32>,
+    @builtin(num_workgroups) num_groups: vec3<u32>
+) {
+    let line = group_id.x + group_id.y * num_groups.x;
+    if (line >= params.lines) {
+        return;
+    }
+
+    let base = (line / params.lines_per_batch) * params.batch_stride + (line % params.lines_per_batch) * params.line_stride;
+
+    for (var i = local_id.x; i < FFT_LENGTH; i += THREADS) {
+        scratch[i] = load_input(base + i * params.elem_stride);
+    }
+    workgroupBarrier();
+
+    var src = 0u;
+    var dst = FFT_LENGTH;
+    var span = 1u;
+    for (var stage = 0u; stage < params.stages; stage++) {
+        let radix = params.radices[stage / 4u][stage % 4u];
+        let groups = FFT_LENGTH / radix;
+
+        for (var j = local_id.x; j < groups; j += THREADS) {
+            let k = j % span;
+
+            // Input twiddle exp(∓2πi * r * k / (span * radix)) is entry r * k * FFT_LENGTH / (span * radix)
+            let twiddle_step = FFT_LENGTH / (span * radix);
+            var v: array<vec2<f32>, 7>;
+            for (var r = 0u; r < radix; r++) {
+                v[r] = complex_mul(scratch[src + j + r * groups], twiddles[r * k * twiddle_step]);
+            }
+
+            // Radix-point DFT; exp(∓2πi * r * q / radix) is entry ((r * q) % radix) * groups.
+            // Stockham autosort: results land in natural order after the last stage
+            let out_idx = (j / span) * span * radix + k;
+            for (var q = 0u; q < radix; q++) {
+                var acc = v[0];
+                for (var r = 1u; r < radix; r++) {
+                    acc += complex_mul(v[r], twiddles[((r * q) % radix) * groups]);
+                }
+                scratch[dst + out_idx + q * span] = acc;
+            }
+        }
+        workgroupBarrier();
+
+        let previous = src;
+        src = dst;
+        dst = previous;
+        span = span * radix;
+    }
+
+    for (var i = local_id.x; i < FFT_LENGTH; i += THREADS) {
+        store_output(base + i * params.elem_stride, scratch[src + i] * params.scale);
+    }
+}
@@ -0,0 +1,75 @@
+{{ENABLE_F16}}
+
+struct StageParams {
+    n: u32,           // transform length
+    lines: u32,       // number of independent transforms
+    line_stride: u32, // distance between the first elements of consecutive lines
+    elem_stride: u32, // distance between consecutive elements of one line
+    radix: u32,       // 2, 3, 4, 5 or 7
+    span: u32,        // product of the radices of the earlier stages
+    scale: f32,       // applied on write, the normalization on the last stage
+    lines_per_batch: u32, // lines of one batch member
+    batch_stride: u32,    // distance between consecutive batch members
+    pad0: u32,
+    pad1: u32,
+    pad2: u32,
+}
+
+@group(0) @binding(0) var<storage, read> input: array<{{FIELD_IN}}>;
+@group(0) @binding(1) var<storage, read_write> output: array<{{FIELD_OUT}}>;
+@group(0) @binding(2) var<uniform> params: StageParams;
+@group(0) @binding(3) var<storage, read> twiddles: array<vec2<f32>>; // n entries for this direction
+{{FUSED_OPERAND}}
+
+fn complex_mul(a: vec2<f32>, b: vec2<f32>) -> vec2<f32> {
+    return vec2<f32>(a.x * b.x - a.y * b.y, a.x * b.y + a.y * b.x);
+}
+
+// Input element i, times the factor when the plan fuses a multiply into its first read
+fn load_input(i: u32) -> vec2<f32> {
+    var x = vec2<f32>(input[i]);
+    {{FUSED_LOAD}}
+    return x;
+}
+
+// Writes output element i, subtracted from the minuend when the plan fuses one into its last write
+fn store_output(i: u32, result: vec2<f32>) {
+    var value = result;
+    {{FUSED_STORE}}
+    output[i] = {{FIELD_OUT}}(value);
+}
+
+// One mixed-radix Stockham stage through global memory, for lines too long for
+// workgroup memory. Each invocation computes one radix-point butterfly of one line.
+@compute @workgroup_size({{WORKGROUP_SIZE}})
+fn main(@builtin(global_invocation_id) global_id: vec3<u32>, @builtin(num_workgroups) num_groups: vec3<u32>) {
+    let idx = global_id.x + global_id.y * num_groups.x * {{WORKGROUP_SIZE_X}}u;
+    let radix = params.radix;
+    let span = params.span;
+    let groups = params.n / radix;
+    if (idx >= params.lines * groups) {
+        return;
+    }
+
+    let line = idx / groups;
+    let j = idx % groups;
+    let k = j % span;
+    let base = (line / params.lines_per_batch) * params.batch_stride + (line % params.lines_per_batch) * params.line_stride;
+
+    // Input twiddle exp(∓2πi * r * k / (span * radix)) is entry r * k * n / (span * radix)
+    let twiddle_step = params.n / (span * radix);
+    var v: array<vec2<f32>, 7>;
+    for (var r = 0u; r < radix; r++) {
+        v[r] = complex_mul(load_input(base + (j + r * groups) * params.elem_stride), twiddles[r * k * twiddle_step]);
+    }
+
+    // Radix-point DFT; exp(∓2πi * r * q / radix) is entry ((r * q) % radix) * groups
+    let out_idx = (j / span) * span * radix + k;
+    for (var q = 0u; q < radix; q++) {
+        var acc = v[0];
+        for (var r = 1u; r < radix; r++) {
+            acc += complex_mul(v[r], twiddles[((r * q) % radix) * groups]);
+        }
+        store_output(base + (out_idx + q * span) * params.elem_stride, acc * params.scale);
+    }
+}
@@ -0,0 +1,56 @@
+{{ENABLE_F16}}
+
+struct TransposeParams {
+    rows: u32, // of each input field; the output fields are cols x rows
+    cols: u32,
+    batch: u32,
+    pad0: u32,
+}
+
+@group(0) @binding(0) var<storage, read> input: array<{{FIELD_IN}}>;
+@group(0) @binding(1) var<storage, read_write> output: array<{{FIELD_OUT}}>;
+@group(0) @binding(2) var<uniform> params: TransposeParams;
+{{FUSED_OPERAND}}
+
+const TILE: u32 = {{WORKGROUP_SIZE_X}}u;
+
+// Padded by one column so the transposed reads hit distinct banks
+var<workgroup> tile: array<vec2<f32>, {{WORKGROUP_SIZE_X}} * ({{WORKGROUP_SIZE_X}} + 1)>;
+
+// Input element i, times the factor when the plan fuses a multiply into its first read
+fn load_input(i: u32) -> vec2<f32> {
+    var x = vec2<f32>(input[i]);
+    {{FUSED_LOAD}}
+    return x;
+}
+
+// Writes output element i, subtracted from the minuend when the plan fuses one into its last write
+fn store_output(i: u32, result: vec2<f32>) {
+    var value = result;
+    {{FUSED_STORE}}
+    output[i] = {{FIELD_OUT}}(value);
+}
+
+// Tiled transpose of each rows x cols field of a batch (one field per workgroup_id.z).
+// Both the global read and the global write walk consecutive addresses; the
+// transposition itself happens in workgroup memory.
+@compute @workgroup_size({{WORKGROUP_SIZE}})
+fn main(
+    @builtin(local_invocation_id) local_id: vec3<u32>,
+    @builtin(workgroup_id) group_id: vec3<u32>
+) {
+    let base = group_id.z * params.rows * params.cols;
+
+    let col = group_id.x * TILE + local_id.x;
+    let row = group_id.y * TILE + local_id.y;
+    if (row < params.rows && col < params.cols) {
+        tile[local_id.y * (TILE + 1u) + local_id.x] = load_input(base + row * params.cols + col);
+    }
+    workgroupBarrier();
+
+    let out_row = group_id.x * TILE + local_id.y;
+    let out_col = group_id.y * TILE + local_id.x;
+    if (out_row < params.cols && out_col < params.rows) {
+        store_output(base + out_row * params.rows + out_col, tile[local_id.x * (TILE + 1u) + local_id.y]);
+    }
+}
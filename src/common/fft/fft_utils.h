@@ -2,7 +2,28 @@
 #define FFT_UTILS_H
 
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <stdexcept>
+#include <vector>
+
+// Scaling convention, as in numpy.fft: Backward leaves the forward transform unscaled and
+// divides the inverse by n, Forward the reverse, Ortho scales both by 1/sqrt(n), None neither
+enum class FFTNorm { None, Forward, Backward, Ortho };
+
+// Factor applied to a transform of n points in the given direction
+inline float normScale(FFTNorm norm, bool inverse, size_t n) {
+    switch (norm) {
+    case FFTNorm::Forward:
+        return inverse ? 1.0f : float(1.0 / double(n));
+    case FFTNorm::Backward:
+        return inverse ? float(1.0 / double(n)) : 1.0f;
+    case FFTNorm::Ortho:
+        return float(1.0 / std::sqrt(double(n)));
+    default:
+        return 1.0f;
+    }
+}
 
 // Check if a number is a power of 2
 inline bool isPowerOf2(int n) {
@@ -28,4 +49,33 @@ inline bool isValidFFTDimensions(int rows, int cols) {
     return isPowerOf2(rows) && isPowerOf2(cols);
 }
 
+// Split n into Stockham stage radices (2, 3, 5, 7, or 4 for pairs of 2s when radix4 is set);
+// false when n has another prime factor
+inline bool factorRadices(uint32_t n, std::vector<uint32_t>& radices, bool radix4 = false) {
+    radices.clear();
+    if (n == 0) {
+        return false;
+    }
+    while (radix4 && n % 4 == 0) {
+        radices.push_back(4);
+        n /= 4;
+    }
+    for (uint32_t radix : {2u, 3u, 5u, 7u}) {
+        while (n % radix == 0) {
+            radices.push_back(radix);
+            n /= radix;
+        }
+    }
+    return n == 1;
+}
+
+// Smallest power of 2 >= n
+inline uint32_t nextPowerOf2(uint32_t n) {
+    uint32_t power = 1;
+    while (power < n) {
+        power <<= 1;
+    }
+    return power;
+}
+
 #endif // FFT_UTILS_H
@@ -0,0 +1,124 @@
+#include "twiddle.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+enum TableKind : uint64_t {
+    TwiddleTable = 0,
+    ChirpTable = 1,
+    BluesteinSpectrum = 2,
+};
+
+static uint64_t tableKey(TableKind kind, uint32_t length, bool inverse) {
+    return (uint64_t(kind) << 40) | (uint64_t(length) << 1) | (inverse ? 1 : 0);
+}
+
+// Uploads (re, im) pairs, padding empty tables so they can still be bound
+static wgpu::Buffer uploadTable(WebGPUContext& context, uint64_t key, const std::vector<std::complex<double>>& values) {
+    std::vector<float> table(2 * std::max<size_t>(values.size(), 1), 0.0f);
+    for (size_t k = 0; k < values.size(); k++) {
+        table[2 * k] = float(values[k].real());
+        table[2 * k + 1] = float(values[k].imag());
+    }
+
+    wgpu::Buffer buffer = createBuffer(context.device, table.data(), sizeof(float) * table.size(), wgpu::BufferUsage::Storage);
+    context.twiddleTables.emplace(key, buffer);
+    return buffer;
+}
+
+// exp(∓iπ k² / n), with k² reduced mod 2n in integers to keep the angle small
+static std::vector<std::complex<double>> chirp(uint32_t length, bool inverse) {
+    const double pi = std::acos(-1.0);
+    double sign = inverse ? 1.0 : -1.0;
+    std::vector<std::complex<double>> values(length);
+    for (uint32_t k = 0; k < length; k++) {
+        uint64_t phase = (uint64_t(k) * k) % (2 * uint64_t(length));
+        values[k] = std::polar(1.0, sign * pi * double(phase) / double(length));
+    }
+    return values;
+}
+
+// In-place iterative radix-2 forward FFT in double precision
+static void hostFFT(std::vector<std::complex<double>>& data) {
+    const double pi = std::acos(-1.0);
+    size_t n = data.size();
+    for (size_t i = 1, j = 0; i < n; i++) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(data[i], data[j]);
+        }
+    }
+    for (size_t len = 2; len <= n; len <<= 1) {
+        std::complex<double> step = std::polar(1.0, -2.0 * pi / double(len));
+        for (size_t start = 0; start < n; start += len) {
+            std::complex<double> w = 1.0;
+            for (size_t k = 0; k < len / 2; k++) {
+                std::complex<double> a = data[start + k];
+                std::complex<double> b = data[start + k + len / 2] * w;
+                data[start + k] = a + b;
+                data[start + k + len / 2] = a - b;
+                w *= step;
+            }
+        }
+    }
+}
+
+wgpu::Buffer getTwiddleTable(WebGPUContext& context, uint32_t length, bool inverse) {
+    uint64_t key = tableKey(TwiddleTable, length, inverse);
+    auto it = context.twiddleTables.find(key);
+    if (it != context.twiddleTables.end()) {
+        return it->second;
+    }
+
+    const double pi = std::acos(-1.0);
+    double sign = inverse ? 1.0 : -1.0;
+    std::vector<std::complex<double>> values(length);
+    for (uint32_t k = 0; k < length; k++) {
+        values[k] = std::polar(1.0, sign * 2.0 * pi * double(k) / double(length));
+    }
+    return uploadTable(context, key, values);
+}
+
+wgpu::Buffer getChirpTable(WebGPUContext& context, uint32_t length, bool inverse) {
+    uint64_t key = tableKey(ChirpTable, length, inverse);
+    auto it = context.twiddleTables.find(key);
+    if (it != context.twiddleTables.end()) {
+        return it->second;
+    }
+    return uploadTable(context, key, chirp(length, inverse));
+}
+
+wgpu::Buffer getBluesteinSpectrum(WebGPUContext& context, uint32_t length, uint32_t paddedLength, bool inverse) {
+    // the padded length is derived from the length, so it does not need to be in the key
+    uint64_t key = tableKey(BluesteinSpectrum, length, inverse);
+    auto it = context.twiddleTables.find(key);
+    if (it != context.twiddleTables.end()) {
+        return it->second;
+    }
+
+    // conj(chirp) at offsets 0..n-1 and their negatives, wrapped into the padded length
+    std::vector<std::complex<double>> w = chirp(length, inverse);
+    std::vector<std::complex<double>> filter(paddedLength, 0.0);
+    for (uint32_t k = 0; k < length; k++) {
+        filter[k] = std::conj(w[k]);
+        if (k > 0) {
+            filter[paddedLength - k] = std::conj(w[k]);
+        }
+    }
+    hostFFT(filter);
+    return uploadTable(context, key, filter);
+}
+
+void releaseTwiddleTables(WebGPUContext& context) {
+    flushStream(context);
+    for (auto& [key, buffer] : context.twiddleTables) {
+        buffer.release();
+    }
+    context.twiddleTables.clear();
+}
@@ -0,0 +1,19 @@
+#ifndef TWIDDLE_H
+#define TWIDDLE_H
+
+#include <webgpu/webgpu.hpp>
+#include "../webgpu_utils.h"
+
+// Returns the read-only table of n complex twiddles exp(∓2πi k / n), k = 0..n-1,
+// (minus for forward, plus for inverse), building and uploading it on first use.
+// Entries are evaluated in double precision on the host. The context owns the buffer.
+wgpu::Buffer getTwiddleTable(WebGPUContext& context, uint32_t length, bool inverse);
+
+// Bluestein tables for a length-n transform: the chirp exp(∓iπ k² / n), k = 0..n-1,
+// and the forward FFT of its conjugate wrapped into a length-m convolution (m >= 2n - 1).
+wgpu::Buffer getChirpTable(WebGPUContext& context, uint32_t length, bool inverse);
+wgpu::Buffer getBluesteinSpectrum(WebGPUContext& context, uint32_t length, uint32_t paddedLength, bool inverse);
+
+void releaseTwiddleTables(WebGPUContext& context);
+
+#endif // TWIDDLE_H
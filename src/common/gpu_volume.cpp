@@ -0,0 +1,130 @@
+#include "gpu_volume.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+static void releaseChunks(std::vector<wgpu::Buffer>& chunks) {
+    for (wgpu::Buffer& chunk : chunks) {
+        chunk.release();
+    }
+    chunks.clear();
+}
+
+GpuVolume::~GpuVolume() {
+    releaseChunks(chunks);
+    releaseChunks(imagChunks);
+}
+
+GpuVolume& GpuVolume::operator=(GpuVolume&& other) noexcept {
+    if (this != &other) {
+        releaseChunks(chunks);
+        releaseChunks(imagChunks);
+        chunks = std::move(other.chunks);
+        imagChunks = std::move(other.imagChunks);
+        other.chunks.clear();
+        other.imagChunks.clear();
+        depth = other.depth;
+        rows = other.rows;
+        cols = other.cols;
+        sliceBytes = other.sliceBytes;
+        sliceStride = other.sliceStride;
+        slicesPerChunk = other.slicesPerChunk;
+    }
+    return *this;
+}
+
+BufferView GpuVolume::slice(size_t z) const {
+    const wgpu::Buffer& chunk = chunks[z / slicesPerChunk];
+    return BufferView(chunk, (z % slicesPerChunk) * sliceStride);
+}
+
+BufferView GpuVolume::imagSlice(size_t z) const {
+    if (imagChunks.empty()) {
+        return BufferView();
+    }
+    const wgpu::Buffer& chunk = imagChunks[z / slicesPerChunk];
+    return BufferView(chunk, (z % slicesPerChunk) * sliceStride);
+}
+
+static bool matchesShape(const GpuVolume& gpuVolume, const Tensor3D& volume) {
+    return volume.depth() == gpuVolume.depth && volume.rows() == gpuVolume.rows && volume.cols() == gpuVolume.cols;
+}
+
+// WRITING SLICES STRAIGHT FROM THE HOST TENSOR
+static void writeChunks(WebGPUContext& context, const GpuVolume& gpuVolume, std::vector<wgpu::Buffer>& chunks, const Tensor3D& volume) {
+    for (size_t chunk = 0; chunk < chunks.size(); chunk++) {
+        size_t first = chunk * gpuVolume.slicesPerChunk;
+        size_t count = std::min(gpuVolume.slicesPerChunk, gpuVolume.depth - first);
+
+        // packed slices go up in one write, padded ones one slice at a time
+        if (gpuVolume.sliceStride == gpuVolume.sliceBytes) {
+            context.queue.writeBuffer(chunks[chunk], 0, volume.sliceData(first), gpuVolume.sliceBytes * count);
+            continue;
+        }
+        for (size_t z = 0; z < count; z++) {
+            context.queue.writeBuffer(chunks[chunk], z * gpuVolume.sliceStride, volume.sliceData(first + z), gpuVolume.sliceBytes);
+        }
+    }
+}
+
+static std::vector<wgpu::Buffer> allocateChunks(WebGPUContext& context, const GpuVolume& gpuVolume) {
+    std::vector<wgpu::Buffer> chunks;
+    for (size_t first = 0; first < gpuVolume.depth; first += gpuVolume.slicesPerChunk) {
+        size_t count = std::min(gpuVolume.slicesPerChunk, gpuVolume.depth - first);
+        chunks.push_back(createBuffer(
+            context.device,
+            nullptr,
+            count * gpuVolume.sliceStride,
+            WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopyDst)
+        ));
+    }
+    return chunks;
+}
+
+GpuVolume uploadVolume(WebGPUContext& context, const Tensor3D& volume) {
+    const DeviceCapabilities& caps = context.capabilities;
+
+    GpuVolume gpuVolume;
+    gpuVolume.depth = volume.depth();
+    gpuVolume.rows = volume.rows();
+    gpuVolume.cols = volume.cols();
+    gpuVolume.sliceBytes = sizeof(float) * gpuVolume.sliceLen();
+    if (volume.empty()) {
+        gpuVolume.slicesPerChunk = 1;
+        return gpuVolume;
+    }
+
+    uint64_t alignment = std::max<uint64_t>(caps.minStorageBufferOffsetAlignment, sizeof(float));
+    gpuVolume.sliceStride = (gpuVolume.sliceBytes + alignment - 1) / alignment * alignment;
+    if (gpuVolume.sliceStride > caps.maxBufferSize || gpuVolume.sliceBytes > caps.maxStorageBufferBindingSize) {
+        throw std::runtime_error("Volume slice of " + std::to_string(gpuVolume.sliceBytes) + " bytes exceeds the device buffer limits");
+    }
+    gpuVolume.slicesPerChunk = std::max<size_t>(1, std::min<uint64_t>(caps.maxBufferSize / gpuVolume.sliceStride, gpuVolume.depth));
+
+    gpuVolume.chunks = allocateChunks(context, gpuVolume);
+    writeChunks(context, gpuVolume, gpuVolume.chunks, volume);
+    return gpuVolume;
+}
+
+GpuVolume uploadVolume(WebGPUContext& context, const Tensor3D& volume, const Tensor3D& imagVolume) {
+    GpuVolume gpuVolume = uploadVolume(context, volume);
+    if (!matchesShape(gpuVolume, imagVolume)) {
+        throw std::runtime_error("Imaginary volume shape does not match the real volume");
+    }
+
+    gpuVolume.imagChunks = allocateChunks(context, gpuVolume);
+    writeChunks(context, gpuVolume, gpuVolume.imagChunks, imagVolume);
+    return gpuVolume;
+}
+
+void updateVolume(WebGPUContext& context, GpuVolume& gpuVolume, const Tensor3D& volume) {
+    if (!matchesShape(gpuVolume, volume)) {
+        throw std::runtime_error("Volume shape does not match the uploaded volume");
+    }
+
+    // queue writes land before any later submit, so commands still reading the old volume go first
+    flushStream(context);
+    writeChunks(context, gpuVolume, gpuVolume.chunks, volume);
+}
@@ -0,0 +1,47 @@
+#ifndef GPU_VOLUME_H
+#define GPU_VOLUME_H
+
+#include "webgpu_utils.h"
+#include "tensor.h"
+#include <vector>
+
+// Refractive-index volume uploaded once and kept on the device.
+// Slices are real f32 planes packed at a stride aligned to
+// minStorageBufferOffsetAlignment, so kernels bind slice z by offset. Volumes
+// larger than maxBufferSize are split into several chunk buffers. The imaginary
+// (absorption) channel uses the same layout and is only allocated when given.
+// The volume owns its chunks outright rather than borrowing them from the buffer
+// pool: they live for a whole run and would otherwise stay pinned as idle pool
+// buffers after it.
+struct GpuVolume {
+    std::vector<wgpu::Buffer> chunks;
+    std::vector<wgpu::Buffer> imagChunks;
+    size_t depth = 0;
+    size_t rows = 0;
+    size_t cols = 0;
+    uint64_t sliceBytes = 0;
+    uint64_t sliceStride = 0;
+    size_t slicesPerChunk = 0;
+
+    GpuVolume() = default;
+    ~GpuVolume();
+    GpuVolume(GpuVolume&& other) noexcept = default;
+    GpuVolume& operator=(GpuVolume&& other) noexcept;
+    GpuVolume(const GpuVolume&) = delete;
+    GpuVolume& operator=(const GpuVolume&) = delete;
+
+    size_t sliceLen() const { return rows * cols; }
+    bool hasImag() const { return !imagChunks.empty(); }
+    BufferView slice(size_t z) const;
+    // Empty view when the volume has no imaginary channel
+    BufferView imagSlice(size_t z) const;
+};
+
+// Allocates device storage for the volume and uploads it
+GpuVolume uploadVolume(WebGPUContext& context, const Tensor3D& volume);
+GpuVolume uploadVolume(WebGPUContext& context, const Tensor3D& volume, const Tensor3D& imagVolume);
+
+// Rewrites the real channel of an uploaded volume in place; the shape must match the original upload
+void updateVolume(WebGPUContext& context, GpuVolume& gpuVolume, const Tensor3D& volume);
+
+#endif
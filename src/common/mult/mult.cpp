@@ -1,7 +1,5 @@
 #include "mult.h"
 
-static size_t buffer_len;
-
 // CREATING BIND GROUP AND LAYOUT
 static wgpu::BindGroupLayout createBindGroupLayout(wgpu::Device& device) {
     wgpu::BindGroupLayoutEntry inputBuffer1Layout = {};
@@ -33,7 +31,9 @@ static wgpu::BindGroup createBindGroup(
     wgpu::BindGroupLayout bindGroupLayout, 
     wgpu::Buffer inputBuffer1, 
     wgpu::Buffer inputBuffer2,
-    wgpu::Buffer outputBuffer
+    wgpu::Buffer outputBuffer,
+    size_t buffer_len,
+    size_t factor_len
 ) {
     wgpu::BindGroupEntry inputEntry1 = {};
     inputEntry1.binding = 0;
@@ -45,7 +45,7 @@ static wgpu::BindGroup createBindGroup(
     inputEntry2.binding = 1;
     inputEntry2.buffer = inputBuffer2;
     inputEntry2.offset = 0;
-    inputEntry2.size = sizeof(float) * buffer_len;
+    inputEntry2.size = sizeof(float) * factor_len;
 
     wgpu::BindGroupEntry outputEntry = {};
     outputEntry.binding = 2;
@@ -68,41 +68,34 @@ void mult(
     wgpu::Buffer& outputBuffer, 
     wgpu::Buffer& inputBuffer1, // forward
     wgpu::Buffer& inputBuffer2, // pupil
-    size_t bufferlen
+    size_t bufferlen,
+    size_t factorlen
 ) {
-    buffer_len = bufferlen;
+    size_t buffer_len = bufferlen;
+    size_t factor_len = factorlen ? factorlen : bufferlen;
 
     // INITIALIZING WEBGPU
     wgpu::Device device = context.device;
-    wgpu::Queue queue = context.queue;
 
     // LOADING AND COMPILING SHADER CODE
-    WorkgroupLimits limits = getWorkgroupLimits(device);
-    std::string shaderCode = readShaderFile("src/common/mult/mult.wgsl", limits.maxWorkgroupSizeX);
-    wgpu::ShaderModule shaderModule = createShaderModule(device, shaderCode);
+    LaunchConfig launch = linearLaunch(context, buffer_len);
+    CachedPipeline cached = getComputePipeline(context, "src/common/mult/mult.wgsl", createBindGroupLayout, launch.workgroupSizeX);
 
     // CREATING BIND GROUP AND LAYOUT
-    wgpu::BindGroupLayout bindGroupLayout = createBindGroupLayout(device);
+    wgpu::BindGroupLayout bindGroupLayout = cached.bindGroupLayout;
     wgpu::BindGroup bindGroup = createBindGroup(
         device, 
         bindGroupLayout, 
         inputBuffer1,
         inputBuffer2,
-        outputBuffer
+        outputBuffer,
+        buffer_len,
+        factor_len
     );
 
     // CREATING COMPUTE PIPELINE
-    wgpu::ComputePipeline computePipeline = createComputePipeline(device, shaderModule, bindGroupLayout);
+    wgpu::ComputePipeline computePipeline = cached.pipeline;
 
     // ENCODING AND DISPATCHING COMPUTE COMMANDS
-    uint32_t workgroupsX = std::ceil(double(buffer_len)/limits.maxWorkgroupSizeX);
-    wgpu::CommandBuffer commandBuffer = createComputeCommandBuffer(device, computePipeline, bindGroup, workgroupsX);
-    queue.submit(1, &commandBuffer);
-
-    // RELEASE RESOURCES
-    commandBuffer.release();
-    computePipeline.release();
-    bindGroup.release();
-    bindGroupLayout.release();
-    shaderModule.release();
+    dispatchCompute(context, computePipeline, bindGroup, launch);
 }
\ No newline at end of file
@@ -3,12 +3,13 @@
 @group(0) @binding(2) var<storage, read_write> output_result: array<vec2<f32>>;
 
 @compute @workgroup_size({{WORKGROUP_SIZE}})
-fn main(@builtin(global_invocation_id) id: vec3<u32>) {
-    let i = id.x;
+fn main(@builtin(global_invocation_id) id: vec3<u32>, @builtin(num_workgroups) num_groups: vec3<u32>) {
+    let i = id.x + id.y * num_groups.x * {{WORKGROUP_SIZE_X}}u;
     if (i >= arrayLength(&output_result)) {
         return;
     }
-    if (pupil[i] == 1) {
+    // one pupil is shared by every field of a batch
+    if (pupil[i % arrayLength(&pupil)] == 1) {
         output_result[i] = forward[i];
     }
     else {
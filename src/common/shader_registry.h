@@ -0,0 +1,11 @@
+#ifndef SHADER_REGISTRY_H
+#define SHADER_REGISTRY_H
+
+#include <string_view>
+
+// Returns the WGSL source embedded at build time for a shader id
+// (its path from the repo root), or an empty view if it is unknown.
+// Defined in the source generated by cmake/embed_shaders.cmake.
+std::string_view findEmbeddedShader(std::string_view id);
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef TENSOR_H
+#define TENSOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <vector>
+
+// Allocator handing out storage aligned for SIMD loads and direct GPU uploads
+template <typename T, size_t Alignment = 64>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+    }
+    void deallocate(T* ptr, size_t) {
+        ::operator delete(ptr, std::align_val_t(Alignment));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
+
+using AlignedFloats = std::vector<float, AlignedAllocator<float>>;
+
+// Non-owning row-major view of a rows x cols plane, e.g. one slice of a Tensor3D
+class Tensor2DView {
+public:
+    Tensor2DView() = default;
+    Tensor2DView(const float* data, size_t rows, size_t cols) : ptr(data), numRows(rows), numCols(cols) {}
+
+    const float* data() const { return ptr; }
+    size_t rows() const { return numRows; }
+    size_t cols() const { return numCols; }
+    size_t size() const { return numRows * numCols; }
+    bool empty() const { return size() == 0; }
+
+    const float& operator()(size_t row, size_t col) const { return ptr[row * numCols + col]; }
+    const float* row(size_t index) const { return ptr + index * numCols; }
+    const float* begin() const { return ptr; }
+    const float* end() const { return ptr + size(); }
+
+private:
+    const float* ptr = nullptr;
+    size_t numRows = 0;
+    size_t numCols = 0;
+};
+
+// Contiguous, aligned depth x rows x cols float volume; slices are zero-copy views
+class Tensor3D {
+public:
+    Tensor3D() = default;
+    Tensor3D(size_t depth, size_t rows, size_t cols, float value = 0.0f)
+        : storage(depth * rows * cols, value), numSlices(depth), numRows(rows), numCols(cols) {}
+
+    // Copies a packed depth x rows x cols block
+    static Tensor3D fromData(const float* data, size_t depth, size_t rows, size_t cols) {
+        Tensor3D tensor(depth, rows, cols);
+        if (tensor.size() > 0) {
+            std::memcpy(tensor.data(), data, sizeof(float) * tensor.size());
+        }
+        return tensor;
+    }
+
+    float* data() { return storage.data(); }
+    const float* data() const { return storage.data(); }
+    size_t depth() const { return numSlices; }
+    size_t rows() const { return numRows; }
+    size_t cols() const { return numCols; }
+    size_t sliceSize() const { return numRows * numCols; }
+    size_t size() const { return storage.size(); }
+    bool empty() const { return storage.empty(); }
+
+    float& operator()(size_t z, size_t row, size_t col) { return storage[(z * numRows + row) * numCols + col]; }
+    const float& operator()(size_t z, size_t row, size_t col) const { return storage[(z * numRows + row) * numCols + col]; }
+
+    Tensor2DView slice(size_t z) const { return Tensor2DView(sliceData(z), numRows, numCols); }
+    float* sliceData(size_t z) { return storage.data() + z * sliceSize(); }
+    const float* sliceData(size_t z) const { return storage.data() + z * sliceSize(); }
+
+    bool sameShape(const Tensor3D& other) const {
+        return numSlices == other.numSlices && numRows == other.numRows && numCols == other.numCols;
+    }
+    void fill(float value) { std::fill(storage.begin(), storage.end(), value); }
+
+private:
+    AlignedFloats storage;
+    size_t numSlices = 0;
+    size_t numRows = 0;
+    size_t numCols = 0;
+};
+
+// Copies one packed rows x cols slice into slice z
+inline void storeSlice(Tensor3D& tensor, size_t z, const float* data) {
+    std::memcpy(tensor.sliceData(z), data, sizeof(float) * tensor.sliceSize());
+}
+
+// Splits interleaved (real, imag) pairs into slices z and z + 1
+inline void storeComplexSlice(Tensor3D& tensor, size_t z, const float* data) {
+    float* realSlice = tensor.sliceData(z);
+    float* imagSlice = tensor.sliceData(z + 1);
+    for (size_t i = 0; i < tensor.sliceSize(); i++) {
+        realSlice[i] = data[i * 2];
+        imagSlice[i] = data[i * 2 + 1];
+    }
+}
+
+#endif
@@ -5,8 +5,6 @@ struct Params {
     uint32_t trunc_flag;
 };
 
-static size_t out_buffer_len;
-
 // CREATING BIND GROUP AND LAYOUT
 static wgpu::BindGroupLayout createBindGroupLayout(wgpu::Device& device) {
     wgpu::BindGroupLayoutEntry cbaBufferLayout = {};
@@ -56,7 +54,8 @@ static wgpu::BindGroup createBindGroup(
     wgpu::Buffer shapeBuffer,
     wgpu::Buffer resBuffer,
     wgpu::Buffer outBuffer, 
-    wgpu::Buffer uniformTruncBuffer
+    wgpu::Buffer uniformTruncBuffer,
+    size_t out_buffer_len
 ) {
     wgpu::BindGroupEntry cbaEntry = {};
     cbaEntry.binding = 0;
@@ -117,7 +116,7 @@ void tilt(
     assert(res.value().size() == 3 && "Resolution must have 3 components");
     assert(c_ba.size() == 2 && "This tilt function only support's one angle's c_ba tuple at a time");
 
-    out_buffer_len =  shape[0] * shape[1];  
+    size_t out_buffer_len =  shape[0] * shape[1];  
     
     Params params = {
         trunc.value() ? 1u : 0u
@@ -125,21 +124,19 @@ void tilt(
 
     // INITIALIZING WEBGPU
     wgpu::Device device = context.device;
-    wgpu::Queue queue = context.queue;
 
     // LOADING AND COMPILING SHADER CODE
-    WorkgroupLimits limits = getWorkgroupLimits(device);
-    std::string shaderCode = readShaderFile("src/common/tilt/tilt.wgsl", limits.maxWorkgroupSizeX);
-    wgpu::ShaderModule shaderModule = createShaderModule(device, shaderCode);
+    LaunchConfig launch = linearLaunch(context, out_buffer_len);
+    CachedPipeline cached = getComputePipeline(context, "src/common/tilt/tilt.wgsl", createBindGroupLayout, launch.workgroupSizeX);
     
     // CREATING BUFFERS FOR TILT
-    wgpu::Buffer anglesBuffer = createBuffer(device, c_ba.data(), sizeof(float) * 2, wgpu::BufferUsage::Storage);
-    wgpu::Buffer shapeBuffer = createBuffer(device, shape.data(), sizeof(int) * 2, wgpu::BufferUsage::Storage);
-    wgpu::Buffer resBuffer = createBuffer(device, res.value().data(), sizeof(float) * 3, wgpu::BufferUsage::Storage);
-    wgpu::Buffer uniformTruncBuffer = createBuffer(device, &params.trunc_flag, sizeof(uint32_t), wgpu::BufferUsage::Uniform);
+    PooledBuffer anglesBuffer = acquireBuffer(context, c_ba.data(), sizeof(float) * 2, wgpu::BufferUsage::Storage);
+    PooledBuffer shapeBuffer = acquireBuffer(context, shape.data(), sizeof(int) * 2, wgpu::BufferUsage::Storage);
+    PooledBuffer resBuffer = acquireBuffer(context, res.value().data(), sizeof(float) * 3, wgpu::BufferUsage::Storage);
+    PooledBuffer uniformTruncBuffer = acquireBuffer(context, &params.trunc_flag, sizeof(uint32_t), wgpu::BufferUsage::Uniform);
 
     // CREATING BIND GROUP AND LAYOUT
-    wgpu::BindGroupLayout bindGroupLayout = createBindGroupLayout(device);
+    wgpu::BindGroupLayout bindGroupLayout = cached.bindGroupLayout;
     wgpu::BindGroup bindGroup = createBindGroup(
         device, 
         bindGroupLayout,
@@ -147,25 +144,15 @@ void tilt(
         shapeBuffer, 
         resBuffer,
         outBuffer,  
-        uniformTruncBuffer
+        uniformTruncBuffer,
+        out_buffer_len
     );
 
     // CREATING COMPUTE PIPELINE
-    wgpu::ComputePipeline computePipeline = createComputePipeline(device, shaderModule, bindGroupLayout);
+    wgpu::ComputePipeline computePipeline = cached.pipeline;
 
     // ENCODING AND DISPATCHING COMPUTE COMMANDS
-    uint32_t workgroupsX = std::ceil(double(out_buffer_len)/limits.maxWorkgroupSizeX);
-    wgpu::CommandBuffer commandBuffer = createComputeCommandBuffer(device, computePipeline, bindGroup, workgroupsX);
-    queue.submit(1, &commandBuffer);
+    dispatchCompute(context, computePipeline, bindGroup, launch);
     
     // RELEASE RESOURCES
-    commandBuffer.release();
-    computePipeline.release();
-    bindGroup.release();
-    bindGroupLayout.release();
-    shaderModule.release();
-    anglesBuffer.release();
-    shapeBuffer.release();
-    resBuffer.release();
-    uniformTruncBuffer.release();
 }
\ No newline at end of file
@@ -13,8 +13,8 @@ fn cexp(theta: f32) -> vec2<f32> {
 }
 
 @compute @workgroup_size({{WORKGROUP_SIZE}})
-fn main(@builtin(global_invocation_id) global_id: vec3<u32>) {
-    let idx = global_id.x;
+fn main(@builtin(global_invocation_id) global_id: vec3<u32>, @builtin(num_workgroups) num_groups: vec3<u32>) {
+    let idx = global_id.x + global_id.y * num_groups.x * {{WORKGROUP_SIZE_X}}u;
     let shape_x = u32(shape[1]);
     let shape_y = u32(shape[0]);
     let total_pixels = shape_x * shape_y;
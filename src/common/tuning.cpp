@@ -0,0 +1,227 @@
+#include "tuning.h"
+
+#include "complex_mult/complex_mult.h"
+#include "fft/fft.h"
+#include "fft/fft_plan.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <vector>
+
+static const char* tuningFileName = "wgpu_ssnp_tuning.txt";
+
+static std::string envOrEmpty(const char* name) {
+    const char* value = std::getenv(name);
+    return value && *value ? value : "";
+}
+
+// Per-user cache dir: %LOCALAPPDATA% on Windows, else $XDG_CACHE_HOME or ~/.cache.
+// Falls back to the working directory when none of them is set.
+std::string tuningFilePath() {
+    std::string path = envOrEmpty("WGPU_SSNP_TUNING");
+    if (!path.empty()) {
+        return path;
+    }
+
+#ifdef _WIN32
+    std::filesystem::path cacheDir = envOrEmpty("LOCALAPPDATA");
+#else
+    std::filesystem::path cacheDir = envOrEmpty("XDG_CACHE_HOME");
+    if (cacheDir.empty() && !envOrEmpty("HOME").empty()) {
+        cacheDir = std::filesystem::path(envOrEmpty("HOME")) / ".cache";
+    }
+#endif
+    if (cacheDir.empty()) {
+        return tuningFileName;
+    }
+    return (cacheDir / "wgpu-ssnp" / tuningFileName).string();
+}
+
+// Entries are tab separated, so keep tabs and newlines out of the driver strings
+static std::string sanitize(std::string text) {
+    std::replace(text.begin(), text.end(), '\t', ' ');
+    std::replace(text.begin(), text.end(), '\n', ' ');
+    std::replace(text.begin(), text.end(), '\r', ' ');
+    return text;
+}
+
+std::string tuningKey(const DeviceCapabilities& caps) {
+    std::ostringstream key;
+    key << sanitize(caps.adapterName) << " | " << sanitize(caps.driverDescription)
+        << " | " << std::hex << caps.vendorID << ":" << caps.deviceID;
+    return key.str();
+}
+
+// TUNING FILE: "<key>\tlinear=256 tile=16 fft_threads=64 radix4=1"
+static std::string formatTuning(const TuningConfig& tuning) {
+    std::ostringstream line;
+    line << "linear=" << tuning.linearWorkgroupSize << " tile=" << tuning.tileSize2D
+         << " fft_threads=" << tuning.fftThreadsPerLine << " radix4=" << (tuning.fftRadix4 ? 1 : 0);
+    return line.str();
+}
+
+static TuningConfig parseTuning(const std::string& values) {
+    TuningConfig tuning;
+    std::istringstream fields(values);
+    std::string field;
+    while (fields >> field) {
+        size_t eq = field.find('=');
+        if (eq == std::string::npos) {
+            continue;
+        }
+        std::string name = field.substr(0, eq);
+        uint32_t value = uint32_t(std::strtoul(field.c_str() + eq + 1, nullptr, 10));
+        if (name == "linear") {
+            tuning.linearWorkgroupSize = value;
+        } else if (name == "tile") {
+            tuning.tileSize2D = value;
+        } else if (name == "fft_threads") {
+            tuning.fftThreadsPerLine = value;
+        } else if (name == "radix4") {
+            tuning.fftRadix4 = value != 0;
+        }
+    }
+    return tuning;
+}
+
+bool loadTuning(WebGPUContext& context, const std::string& path) {
+#ifdef __EMSCRIPTEN__
+    (void)context;
+    (void)path;
+    return false;
+#else
+    std::ifstream file(path);
+    std::string key = tuningKey(context.capabilities);
+    std::string line;
+    while (std::getline(file, line)) {
+        size_t tab = line.find('\t');
+        if (tab != std::string::npos && line.compare(0, tab, key) == 0) {
+            context.tuning = parseTuning(line.substr(tab + 1));
+            return true;
+        }
+    }
+    return false;
+#endif
+}
+
+bool saveTuning(const WebGPUContext& context, const std::string& path) {
+#ifdef __EMSCRIPTEN__
+    (void)context;
+    (void)path;
+    return false;
+#else
+    std::string key = tuningKey(context.capabilities);
+    std::vector<std::string> lines;
+    {
+        std::ifstream file(path);
+        std::string line;
+        while (std::getline(file, line)) {
+            size_t tab = line.find('\t');
+            if (!line.empty() && (tab == std::string::npos || line.compare(0, tab, key) != 0)) {
+                lines.push_back(line);
+            }
+        }
+    }
+    lines.push_back(key + "\t" + formatTuning(context.tuning));
+
+    // The cache dir may not exist yet on a first tuning run
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) {
+        std::error_code error;
+        std::filesystem::create_directories(parent, error);
+    }
+
+    std::ofstream file(path, std::ios::trunc);
+    for (const std::string& line : lines) {
+        file << line << "\n";
+    }
+    return bool(file);
+#endif
+}
+
+// Wall time of runs recorded launches, after one warm-up run that also builds the pipelines
+static double timeRuns(WebGPUContext& context, wgpu::Buffer& sync, int runs, const std::function<void()>& launch) {
+    launch();
+    readBack(context, 1, sync);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    {
+        GpuStreamScope scope(context);
+        for (int run = 0; run < runs; run++) {
+            launch();
+        }
+    }
+    readBack(context, 1, sync);
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Tries each candidate for one knob, keeping the fastest; plans are rebuilt per candidate
+template <typename T>
+static void tuneKnob(WebGPUContext& context, T& knob, const std::vector<T>& candidates, const std::function<double()>& measure) {
+    T best = knob;
+    double bestTime = -1.0;
+    for (const T& candidate : candidates) {
+        knob = candidate;
+        releaseFFTPlans(context);
+        double time = measure();
+        if (bestTime < 0.0 || time < bestTime) {
+            bestTime = time;
+            best = candidate;
+        }
+    }
+    knob = best;
+    releaseFFTPlans(context);
+}
+
+TuningConfig autotune(WebGPUContext& context, int rows, int cols, int runs) {
+    const DeviceCapabilities& caps = context.capabilities;
+    size_t len = size_t(rows) * cols;
+    std::vector<float> field(2 * len, 0.0f);
+    for (size_t i = 0; i < field.size(); i++) {
+        field[i] = float(i % 17) / 17.0f;
+    }
+
+    WGPUBufferUsage usage = WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::CopySrc);
+    PooledBuffer a = acquireBuffer(context, field.data(), field.size() * sizeof(float), usage);
+    PooledBuffer b = acquireBuffer(context, field.data(), field.size() * sizeof(float), usage);
+    PooledBuffer out = acquireBuffer(context, nullptr, field.size() * sizeof(float), usage);
+
+    TuningConfig& tuning = context.tuning;
+    tuning = TuningConfig();
+
+    std::vector<uint32_t> linearSizes;
+    for (uint32_t size = 64; size <= std::min(caps.maxWorkgroupSizeX, caps.maxInvocationsPerWorkgroup); size *= 2) {
+        linearSizes.push_back(size);
+    }
+    tuneKnob<uint32_t>(context, tuning.linearWorkgroupSize, linearSizes, [&]() {
+        return timeRuns(context, out.get(), runs, [&]() { complex_mult(context, out.get(), a.get(), b.get(), len); });
+    });
+
+    auto timeFFT = [&]() {
+        return timeRuns(context, out.get(), runs, [&]() { fft(context, out.get(), a.get(), len, rows, cols, 0); });
+    };
+
+    std::vector<uint32_t> tiles;
+    for (uint32_t tile : {8u, 16u, 32u}) {
+        if (tile * tile <= caps.maxInvocationsPerWorkgroup && tile <= caps.maxWorkgroupSizeX && tile <= caps.maxWorkgroupSizeY) {
+            tiles.push_back(tile);
+        }
+    }
+    tuneKnob<uint32_t>(context, tuning.tileSize2D, tiles, timeFFT);
+
+    // 0 keeps one thread per smallest-radix butterfly
+    std::vector<uint32_t> threadCaps = {0};
+    for (uint32_t threads = 32; threads <= caps.maxWorkgroupSizeX && threads <= caps.maxInvocationsPerWorkgroup; threads *= 2) {
+        threadCaps.push_back(threads);
+    }
+    tuneKnob<uint32_t>(context, tuning.fftThreadsPerLine, threadCaps, timeFFT);
+    tuneKnob<bool>(context, tuning.fftRadix4, {false, true}, timeFFT);
+
+    return tuning;
+}
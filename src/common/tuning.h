@@ -0,0 +1,24 @@
+#ifndef TUNING_H
+#define TUNING_H
+
+#include "webgpu_utils.h"
+#include <string>
+
+// Per-adapter tuning cache: one line per adapter and driver, written by autotune runs
+// and read back by initWebGPU. The file lives in the per-user cache dir
+// (wgpu-ssnp/wgpu_ssnp_tuning.txt) and WGPU_SSNP_TUNING overrides the path. The web
+// build has no file system and always runs with the defaults.
+std::string tuningFilePath();
+// Adapter name, driver and PCI ids; a driver update invalidates the entry
+std::string tuningKey(const DeviceCapabilities& caps);
+
+// Loads this adapter's entry into context.tuning; false when there is none
+bool loadTuning(WebGPUContext& context, const std::string& path = tuningFilePath());
+// Writes context.tuning as this adapter's entry, keeping the other adapters' entries
+bool saveTuning(const WebGPUContext& context, const std::string& path = tuningFilePath());
+
+// Times the candidate launch shapes on rows x cols fields and keeps the fastest in
+// context.tuning. Knobs are tuned one after another, each with the earlier winners fixed.
+TuningConfig autotune(WebGPUContext& context, int rows, int cols, int runs = 10);
+
+#endif // TUNING_H
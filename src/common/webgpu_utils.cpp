@@ -1,4 +1,70 @@
 #include "webgpu_utils.h"
+#include "shader_registry.h"
+#include "tuning.h"
+#include "fft/fft_plan.h"
+#include "fft/twiddle.h"
+#include "../ssnp/propagator/propagator.h"
+
+#include <algorithm>
+
+// CAPTURING DEVICE CAPABILITIES
+static DeviceCapabilities queryCapabilities(WebGPUContext& context) {
+    DeviceCapabilities caps;
+
+    WGPUSupportedLimits limits = {};
+    if (wgpuDeviceGetLimits(context.device, &limits)) {
+        caps.maxWorkgroupSizeX = limits.limits.maxComputeWorkgroupSizeX;
+        caps.maxWorkgroupSizeY = limits.limits.maxComputeWorkgroupSizeY;
+        caps.maxWorkgroupSizeZ = limits.limits.maxComputeWorkgroupSizeZ;
+        caps.maxInvocationsPerWorkgroup = limits.limits.maxComputeInvocationsPerWorkgroup;
+        caps.maxWorkgroupsPerDimension = limits.limits.maxComputeWorkgroupsPerDimension;
+        caps.maxWorkgroupStorageSize = limits.limits.maxComputeWorkgroupStorageSize;
+        caps.maxStorageBufferBindingSize = limits.limits.maxStorageBufferBindingSize;
+        caps.maxBufferSize = limits.limits.maxBufferSize;
+        caps.minStorageBufferOffsetAlignment = limits.limits.minStorageBufferOffsetAlignment;
+        caps.minUniformBufferOffsetAlignment = limits.limits.minUniformBufferOffsetAlignment;
+    } else {
+        // Fall back to the WebGPU spec defaults
+        std::cerr << "Error fetching device limits, using defaults." << std::endl;
+        caps.maxWorkgroupSizeX = 256;
+        caps.maxWorkgroupSizeY = 256;
+        caps.maxWorkgroupSizeZ = 64;
+        caps.maxInvocationsPerWorkgroup = 256;
+        caps.maxWorkgroupsPerDimension = 65535;
+        caps.maxWorkgroupStorageSize = 16384;
+        caps.maxStorageBufferBindingSize = 134217728;
+        caps.maxBufferSize = 268435456;
+        caps.minStorageBufferOffsetAlignment = 256;
+        caps.minUniformBufferOffsetAlignment = 256;
+    }
+
+    uint32_t tile = 1;
+    while ((tile * 2) * (tile * 2) <= caps.maxInvocationsPerWorkgroup) {
+        tile *= 2;
+    }
+    caps.tileSize2D = std::min({tile, caps.maxWorkgroupSizeX, caps.maxWorkgroupSizeY});
+
+    size_t featureCount = wgpuDeviceEnumerateFeatures(context.device, nullptr);
+    std::vector<WGPUFeatureName> features(featureCount);
+    wgpuDeviceEnumerateFeatures(context.device, features.data());
+    for (WGPUFeatureName feature : features) {
+        caps.features.push_back(feature);
+    }
+    caps.shaderF16 = caps.hasFeature(wgpu::FeatureName::ShaderF16);
+
+    WGPUAdapterProperties properties = {};
+    wgpuAdapterGetProperties(context.adapter, &properties);
+    caps.adapterName = properties.name ? properties.name : "";
+    caps.driverDescription = properties.driverDescription ? properties.driverDescription : "";
+    caps.vendorID = properties.vendorID;
+    caps.deviceID = properties.deviceID;
+
+    return caps;
+}
+
+bool DeviceCapabilities::hasFeature(wgpu::FeatureName feature) const {
+    return std::find(features.begin(), features.end(), feature) != features.end();
+}
 
 // INITIALIZING WEBGPU
 void initWebGPU(WebGPUContext& context) {
@@ -21,9 +87,17 @@ void initWebGPU(WebGPUContext& context) {
         std::cerr << "Failed to request a WebGPU adapter." << std::endl;
     }
 
+    // Half-precision field storage is optional, so only ask for it where the adapter has it
+    std::vector<WGPUFeatureName> requiredFeatures;
+    if (context.adapter.hasFeature(wgpu::FeatureName::ShaderF16)) {
+        requiredFeatures.push_back(WGPUFeatureName_ShaderF16);
+    }
+
 #ifdef __EMSCRIPTEN__
     // On web: default device request
     wgpu::DeviceDescriptor devDesc = {};
+    devDesc.requiredFeatureCount = requiredFeatures.size();
+    devDesc.requiredFeatures = requiredFeatures.data();
     context.device = context.adapter.requestDevice(devDesc);
 #else
     // Native: mirror adapter limits 
@@ -37,6 +111,8 @@ void initWebGPU(WebGPUContext& context) {
     wgpu::DeviceDescriptor devDesc = {};
     devDesc.label = "Default Device";
     devDesc.requiredLimits = &requiredLimits;
+    devDesc.requiredFeatureCount = requiredFeatures.size();
+    devDesc.requiredFeatures = requiredFeatures.data();
     context.device = context.adapter.requestDevice(devDesc);
 #endif
     if (!context.device) {
@@ -48,37 +124,107 @@ void initWebGPU(WebGPUContext& context) {
     if (!context.queue) {
         std::cerr << "Failed to retrieve command queue." << std::endl;
     }
+
+    context.capabilities = queryCapabilities(context);
+    loadTuning(context);
 }
 
-// FETCH WORKGROUP LIMITS
-WorkgroupLimits getWorkgroupLimits(wgpu::Device& device) {
-    WGPUSupportedLimits limits = {};
-    WorkgroupLimits result;
-
-    bool success = wgpuDeviceGetLimits(device, &limits);
-    if (success) {
-        result.maxWorkgroupSizeX = double(limits.limits.maxComputeWorkgroupSizeX);
-        result.maxWorkgroupSizeY = double(limits.limits.maxComputeWorkgroupSizeY);
-        result.maxWorkgroupSizeZ = double(limits.limits.maxComputeWorkgroupSizeZ);
-        result.maxInvocationsPerWorkgroup = double(limits.limits.maxComputeInvocationsPerWorkgroup);
-    } else {
-        std::cerr << "Error fetching workgroup limits." << std::endl;
-        result = { -1.0, -1.0, -1.0, -1.0 }; // Return default error values
+// LAUNCH CONFIGURATION
+static void spreadWorkgroups(const DeviceCapabilities& caps, LaunchConfig& launch, size_t groups) {
+    if (groups <= caps.maxWorkgroupsPerDimension) {
+        launch.workgroupsX = uint32_t(groups);
+        return;
+    }
+
+    // Too many workgroups for one dimension, fold the overflow into Y
+    launch.workgroupsX = caps.maxWorkgroupsPerDimension;
+    size_t rows = (groups + launch.workgroupsX - 1) / launch.workgroupsX;
+    if (rows > caps.maxWorkgroupsPerDimension) {
+        throw std::runtime_error("Launch of " + std::to_string(groups) + " workgroups exceeds the device dispatch limits");
+    }
+    launch.workgroupsY = uint32_t(rows);
+}
+
+LaunchConfig linearLaunch(const WebGPUContext& context, size_t invocations) {
+    const DeviceCapabilities& caps = context.capabilities;
+    LaunchConfig launch;
+    launch.workgroupSizeX = caps.maxWorkgroupSizeX;
+    if (context.tuning.linearWorkgroupSize) {
+        launch.workgroupSizeX = std::min({context.tuning.linearWorkgroupSize, caps.maxWorkgroupSizeX, caps.maxInvocationsPerWorkgroup});
+    }
+
+    size_t groups = std::max<size_t>(1, (invocations + launch.workgroupSizeX - 1) / launch.workgroupSizeX);
+    spreadWorkgroups(caps, launch, groups);
+    return launch;
+}
+
+LaunchConfig groupLaunch(const WebGPUContext& context, size_t groups, uint32_t workgroupSize) {
+    const DeviceCapabilities& caps = context.capabilities;
+    LaunchConfig launch;
+    launch.workgroupSizeX = std::max(1u, std::min({workgroupSize, caps.maxWorkgroupSizeX, caps.maxInvocationsPerWorkgroup}));
+    spreadWorkgroups(caps, launch, std::max<size_t>(1, groups));
+    return launch;
+}
+
+LaunchConfig gridLaunch(const WebGPUContext& context, uint32_t cols, uint32_t rows) {
+    const DeviceCapabilities& caps = context.capabilities;
+    LaunchConfig launch;
+    uint32_t tile = caps.tileSize2D;
+    if (context.tuning.tileSize2D && context.tuning.tileSize2D * context.tuning.tileSize2D <= caps.maxInvocationsPerWorkgroup) {
+        tile = std::min({context.tuning.tileSize2D, caps.maxWorkgroupSizeX, caps.maxWorkgroupSizeY});
+    }
+    launch.workgroupSizeX = tile;
+    launch.workgroupSizeY = tile;
+    launch.workgroupsX = std::max(1u, (cols + launch.workgroupSizeX - 1) / launch.workgroupSizeX);
+    launch.workgroupsY = std::max(1u, (rows + launch.workgroupSizeY - 1) / launch.workgroupSizeY);
+    if (launch.workgroupsX > caps.maxWorkgroupsPerDimension || launch.workgroupsY > caps.maxWorkgroupsPerDimension) {
+        throw std::runtime_error("Launch of a " + std::to_string(cols) + "x" + std::to_string(rows) + " grid exceeds the device dispatch limits");
+    }
+    return launch;
+}
+
+// FIELD STORAGE PRECISION
+FieldStorage setFieldStorage(WebGPUContext& context, FieldStorage storage) {
+    if (storage == FieldStorage::F16 && !context.capabilities.shaderF16) {
+        storage = FieldStorage::F32;
     }
+    context.fieldStorage = storage;
+    return storage;
+}
 
-    return result;
+static const char* fieldType(FieldStorage storage) {
+    return storage == FieldStorage::F16 ? "vec2<f16>" : "vec2<f32>";
+}
+
+ShaderConstants fieldStorageConstants(FieldStorage input, FieldStorage output) {
+    bool f16 = input == FieldStorage::F16 || output == FieldStorage::F16;
+    return {
+        {"FIELD_IN", fieldType(input)},
+        {"FIELD_OUT", fieldType(output)},
+        {"ENABLE_F16", f16 ? "enable f16;" : ""},
+    };
+}
+
+static void replaceToken(std::string& shaderCode, const std::string& token, const std::string& value) {
+    for (size_t at = shaderCode.find(token); at != std::string::npos; at = shaderCode.find(token, at + value.size())) {
+        shaderCode.replace(at, token.size(), value);
+    }
 }
 
 // LOADING AND COMPILING SHADER CODE
-std::string readShaderFile(const std::string& filename, int workgroupsX, int workgroupsY, int workgroupsZ) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open shader file: " << filename << std::endl;
-        return "";
+std::string readShaderFile(
+    const std::string& filename,
+    int workgroupsX,
+    int workgroupsY,
+    int workgroupsZ,
+    const ShaderConstants& constants
+) {
+    // Shaders are embedded at build time, no file I/O here
+    std::string_view embedded = findEmbeddedShader(filename);
+    if (embedded.empty()) {
+        throw std::runtime_error("No embedded WGSL shader named " + filename);
     }
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    std::string shaderCode = buffer.str();
+    std::string shaderCode(embedded);
 
     // Write the new workgroup sizes
     std::string workgroups = std::to_string(workgroupsX) + ", " + std::to_string(workgroupsY) + ", " + std::to_string(workgroupsZ);
@@ -89,6 +235,20 @@ std::string readShaderFile(const std::string& filename, int workgroupsX, int wor
     }
     shaderCode.replace(pos, token.size(), workgroups);
 
+    // Linear kernels use the X size to unfold dispatches spilled into Y
+    std::string sizeXToken = "{{WORKGROUP_SIZE_X}}";
+    replaceToken(shaderCode, sizeXToken, std::to_string(workgroupsX));
+
+    // Write any remaining template constants
+    for (const auto& [name, value] : constants) {
+        replaceToken(shaderCode, "{{" + name + "}}", value);
+    }
+
+    // Precision-templated kernels default to f32 fields
+    for (const auto& [name, value] : fieldStorageConstants(FieldStorage::F32, FieldStorage::F32)) {
+        replaceToken(shaderCode, "{{" + name + "}}", value);
+    }
+
     return shaderCode;
 }
 
@@ -128,6 +288,151 @@ wgpu::Buffer createBuffer(wgpu::Device& device, const void* data, size_t size, w
     return buffer;
 }
 
+// POOLED BUFFERS
+static constexpr uint64_t poolBucketBytes = 256;
+
+static void recyclePendingBuffers(WebGPUContext& context) {
+    BufferPool& pool = context.bufferPool;
+    for (auto& [key, buffer] : pool.pendingReturns) {
+        pool.freeBuffers[key].push_back(buffer);
+    }
+    pool.pendingReturns.clear();
+}
+
+PooledBuffer acquireBuffer(WebGPUContext& context, const void* data, size_t size, wgpu::BufferUsage usage) {
+    BufferPool& pool = context.bufferPool;
+    usage = WGPUBufferUsage(usage | wgpu::BufferUsage::CopyDst);
+
+    // Upper 32 bits hold the usage flags, lower bits the bucketed size
+    uint64_t bucketSize = (uint64_t(size) + poolBucketBytes - 1) / poolBucketBytes * poolBucketBytes;
+    uint64_t key = (uint64_t(WGPUBufferUsageFlags(usage)) << 40) | bucketSize;
+
+    wgpu::Buffer buffer = nullptr;
+    auto it = pool.freeBuffers.find(key);
+    if (it != pool.freeBuffers.end() && !it->second.empty()) {
+        buffer = it->second.back();
+        it->second.pop_back();
+        pool.reuses++;
+    } else {
+        buffer = createBuffer(context.device, nullptr, bucketSize, usage);
+        pool.allocations++;
+        pool.totalBytes += bucketSize;
+        pool.peakBytes = std::max(pool.peakBytes, pool.totalBytes);
+    }
+    pool.liveBuffers++;
+    pool.liveBytes += bucketSize;
+
+    if (data) {
+        context.queue.writeBuffer(buffer, 0, data, size);
+    }
+    return PooledBuffer(context, buffer, key, bucketSize);
+}
+
+PooledBuffer::PooledBuffer(WebGPUContext& context, wgpu::Buffer buffer, uint64_t key, uint64_t size)
+    : context(&context), buffer(buffer), key(key), bytes(size) {}
+
+PooledBuffer::~PooledBuffer() {
+    reset();
+}
+
+PooledBuffer::PooledBuffer(PooledBuffer&& other) noexcept
+    : context(other.context), buffer(other.buffer), key(other.key), bytes(other.bytes) {
+    other.context = nullptr;
+    other.buffer = nullptr;
+}
+
+PooledBuffer& PooledBuffer::operator=(PooledBuffer&& other) noexcept {
+    if (this != &other) {
+        reset();
+        context = other.context;
+        buffer = other.buffer;
+        key = other.key;
+        bytes = other.bytes;
+        other.context = nullptr;
+        other.buffer = nullptr;
+    }
+    return *this;
+}
+
+void PooledBuffer::reset() {
+    if (!context || !buffer) {
+        return;
+    }
+    BufferPool& pool = context->bufferPool;
+    pool.liveBuffers--;
+    pool.liveBytes -= bytes;
+
+    // Commands recorded but not yet submitted may still use this buffer
+    if (context->stream.encoder) {
+        pool.pendingReturns.emplace_back(key, buffer);
+    } else {
+        pool.freeBuffers[key].push_back(buffer);
+    }
+    context = nullptr;
+    buffer = nullptr;
+}
+
+BufferPoolStats getBufferPoolStats(const WebGPUContext& context) {
+    const BufferPool& pool = context.bufferPool;
+    BufferPoolStats stats;
+    stats.allocations = pool.allocations;
+    stats.reuses = pool.reuses;
+    stats.liveBuffers = pool.liveBuffers;
+    stats.liveBytes = pool.liveBytes;
+    stats.peakBytes = pool.peakBytes;
+    size_t requests = pool.allocations + pool.reuses;
+    stats.reuseRate = requests > 0 ? double(pool.reuses) / double(requests) : 0.0;
+    return stats;
+}
+
+void releaseBufferPool(WebGPUContext& context) {
+    flushStream(context);
+    BufferPool& pool = context.bufferPool;
+    for (auto& [key, buffers] : pool.freeBuffers) {
+        for (wgpu::Buffer& buffer : buffers) {
+            pool.totalBytes -= buffer.getSize();
+            buffer.release();
+        }
+    }
+    pool.freeBuffers.clear();
+}
+
+void trimBufferPool(WebGPUContext& context, uint64_t maxIdleBytes) {
+    flushStream(context);
+    BufferPool& pool = context.bufferPool;
+
+    // Buffers held by callers are live; everything else in the pool is idle
+    uint64_t idleBytes = pool.totalBytes - pool.liveBytes;
+    if (idleBytes <= maxIdleBytes) {
+        return;
+    }
+
+    std::vector<uint64_t> keys;
+    for (const auto& [key, buffers] : pool.freeBuffers) {
+        keys.push_back(key);
+    }
+    // The low 40 bits of a key are the bucket size
+    constexpr uint64_t sizeMask = (uint64_t(1) << 40) - 1;
+    std::sort(keys.begin(), keys.end(), [](uint64_t a, uint64_t b) { return (a & sizeMask) > (b & sizeMask); });
+
+    for (uint64_t key : keys) {
+        std::vector<wgpu::Buffer>& buffers = pool.freeBuffers[key];
+        while (!buffers.empty() && idleBytes > maxIdleBytes) {
+            uint64_t bytes = key & sizeMask;
+            buffers.back().release();
+            buffers.pop_back();
+            pool.totalBytes -= bytes;
+            idleBytes -= bytes;
+        }
+        if (buffers.empty()) {
+            pool.freeBuffers.erase(key);
+        }
+        if (idleBytes <= maxIdleBytes) {
+            break;
+        }
+    }
+}
+
 // COMPUTE PIPELINE UTILITIES
 wgpu::ComputePipeline createComputePipeline(wgpu::Device& device, wgpu::ShaderModule shaderModule, wgpu::BindGroupLayout bindGroupLayout) {
     // Define pipeline layout
@@ -159,121 +464,351 @@ wgpu::ComputePipeline createComputePipeline(wgpu::Device& device, wgpu::ShaderMo
     return pipeline;
 }
 
-// CREATE COMMAND BUFFER
-wgpu::CommandBuffer createComputeCommandBuffer(
-    wgpu::Device& device,
-    wgpu::ComputePipeline& computePipeline,
-    wgpu::BindGroup& bindGroup,
+// CACHED COMPUTE PIPELINES
+CachedPipeline getComputePipeline(
+    WebGPUContext& context,
+    const std::string& shaderFile,
+    wgpu::BindGroupLayout (*createLayout)(wgpu::Device&),
+    int workgroupsX,
+    int workgroupsY,
+    int workgroupsZ,
+    const ShaderConstants& constants
+) {
+    std::string key = shaderFile + "|" + std::to_string(workgroupsX) + "," + std::to_string(workgroupsY) + "," + std::to_string(workgroupsZ);
+    for (const auto& [name, value] : constants) {
+        key += "|" + name + "=" + value;
+    }
+
+    auto it = context.pipelineCache.find(key);
+    if (it != context.pipelineCache.end()) {
+        context.pipelineCacheHits++;
+        return it->second;
+    }
+    context.pipelineCacheMisses++;
+
+    std::string shaderCode = readShaderFile(shaderFile, workgroupsX, workgroupsY, workgroupsZ, constants);
+    wgpu::ShaderModule shaderModule = createShaderModule(context.device, shaderCode);
+
+    CachedPipeline cached;
+    cached.bindGroupLayout = createLayout(context.device);
+    cached.pipeline = createComputePipeline(context.device, shaderModule, cached.bindGroupLayout);
+    shaderModule.release();
+
+    context.pipelineCache.emplace(key, cached);
+    return cached;
+}
+
+PipelineCacheStats getPipelineCacheStats(const WebGPUContext& context) {
+    PipelineCacheStats stats;
+    stats.hits = context.pipelineCacheHits;
+    stats.misses = context.pipelineCacheMisses;
+    stats.size = context.pipelineCache.size();
+    return stats;
+}
+
+void releasePipelineCache(WebGPUContext& context) {
+    for (auto& [key, cached] : context.pipelineCache) {
+        cached.pipeline.release();
+        cached.bindGroupLayout.release();
+    }
+    context.pipelineCache.clear();
+}
+
+// RECORDING COMMANDS INTO THE CONTEXT STREAM
+static void openEncoder(WebGPUContext& context) {
+    if (!context.stream.encoder) {
+        wgpu::CommandEncoderDescriptor encoderDesc = {};
+        context.stream.encoder = context.device.createCommandEncoder(encoderDesc);
+    }
+}
+
+static void closeComputePass(WebGPUContext& context) {
+    if (context.stream.pass) {
+        context.stream.pass.end();
+        context.stream.pass.release();
+        context.stream.pass = nullptr;
+    }
+}
+
+void beginStream(WebGPUContext& context) {
+    context.stream.depth++;
+}
+
+void endStream(WebGPUContext& context) {
+    if (context.stream.depth > 0 && --context.stream.depth == 0) {
+        flushStream(context);
+    }
+}
+
+void flushStream(WebGPUContext& context) {
+    GpuStream& stream = context.stream;
+    if (!stream.encoder) {
+        return;
+    }
+    closeComputePass(context);
+
+    wgpu::CommandBufferDescriptor cmdBufferDesc = {};
+    wgpu::CommandBuffer commandBuffer = stream.encoder.finish(cmdBufferDesc);
+    context.queue.submit(1, &commandBuffer);
+    stream.submits++;
+
+    commandBuffer.release();
+    stream.encoder.release();
+    stream.encoder = nullptr;
+    for (wgpu::BindGroup& bindGroup : stream.bindGroups) {
+        bindGroup.release();
+    }
+    stream.bindGroups.clear();
+    recyclePendingBuffers(context);
+}
+
+void dispatchCompute(
+    WebGPUContext& context,
+    const wgpu::ComputePipeline& computePipeline,
+    wgpu::BindGroup bindGroup,
     uint32_t workgroupsX,
     uint32_t workgroupsY,
     uint32_t workgroupsZ
 ) {
-    wgpu::CommandEncoderDescriptor encoderDesc = {};
-    wgpu::CommandEncoder commandEncoder = device.createCommandEncoder(encoderDesc);
+    GpuStream& stream = context.stream;
+    openEncoder(context);
+    if (!stream.pass) {
+        wgpu::ComputePassDescriptor computePassDesc = {};
+        stream.pass = stream.encoder.beginComputePass(computePassDesc);
+    }
+    stream.pass.setPipeline(computePipeline);
+    stream.pass.setBindGroup(0, bindGroup, 0, nullptr);
+    stream.pass.dispatchWorkgroups(workgroupsX, workgroupsY, workgroupsZ);
+    stream.bindGroups.push_back(bindGroup);
+    stream.recordedCommands++;
+
+    if (stream.depth == 0) {
+        flushStream(context);
+    }
+}
+
+void dispatchCompute(
+    WebGPUContext& context,
+    const wgpu::ComputePipeline& computePipeline,
+    wgpu::BindGroup bindGroup,
+    const LaunchConfig& launch
+) {
+    dispatchCompute(context, computePipeline, bindGroup, launch.workgroupsX, launch.workgroupsY, launch.workgroupsZ);
+}
 
-    wgpu::ComputePassDescriptor computePassDesc = {};
-    wgpu::ComputePassEncoder computePass = commandEncoder.beginComputePass(computePassDesc);
-    computePass.setPipeline(computePipeline);
-    computePass.setBindGroup(0, bindGroup, 0, nullptr);
-    computePass.dispatchWorkgroups(workgroupsX, workgroupsY, workgroupsZ);
-    computePass.end();
+void copyBufferToBuffer(
+    WebGPUContext& context,
+    const wgpu::Buffer& source,
+    uint64_t sourceOffset,
+    const wgpu::Buffer& destination,
+    uint64_t destinationOffset,
+    uint64_t size
+) {
+    openEncoder(context);
+    closeComputePass(context);
+    context.stream.encoder.copyBufferToBuffer(source, sourceOffset, destination, destinationOffset, size);
+    context.stream.recordedCommands++;
 
-    wgpu::CommandBufferDescriptor cmdBufferDesc = {};
-    return commandEncoder.finish(cmdBufferDesc);
+    if (context.stream.depth == 0) {
+        flushStream(context);
+    }
 }
 
-// READBACK RESULTS FROM GPU TO CPU
-std::vector<float> readBack(wgpu::Device& device, wgpu::Queue& queue, size_t buffer_len, wgpu::Buffer& outputBuffer) {
-    std::vector<float> output(buffer_len);
+void clearBuffer(
+    WebGPUContext& context,
+    const wgpu::Buffer& buffer,
+    uint64_t offset,
+    uint64_t size
+) {
+    openEncoder(context);
+    closeComputePass(context);
+    context.stream.encoder.clearBuffer(buffer, offset, size);
+    context.stream.recordedCommands++;
 
-    wgpu::BufferDescriptor readbackBufferDesc = {};
-    readbackBufferDesc.size = buffer_len * sizeof(float);
-    readbackBufferDesc.usage = wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::MapRead;
-    wgpu::Buffer readbackBuffer = device.createBuffer(readbackBufferDesc);
+    if (context.stream.depth == 0) {
+        flushStream(context);
+    }
+}
 
-    wgpu::CommandEncoderDescriptor encoderDesc = {};
-    wgpu::CommandEncoder copyEncoder = device.createCommandEncoder(encoderDesc);
-    copyEncoder.copyBufferToBuffer(outputBuffer, 0, readbackBuffer, 0, buffer_len * sizeof(float));
+// STAGING RING FOR READBACKS
+// Readbacks in flight at once; past this, a new readback waits for an earlier one to land
+static constexpr size_t maxStagingSlots = 4;
 
-    wgpu::CommandBuffer commandBuffer = copyEncoder.finish();
-    queue.submit(1, &commandBuffer);
+static void waitForGpu(WebGPUContext& context) {
+#ifndef __EMSCRIPTEN__
+    wgpuDevicePoll(context.device, true, nullptr);
+#else
+    emscripten_sleep(1); // Yield to the browser so the map callback can run
+#endif
+}
 
-    //MAPPING BACK TO CPU
-    bool mappingComplete = false;
-    auto handle = readbackBuffer.mapAsync(wgpu::MapMode::Read, 0, buffer_len * sizeof(float), [&](wgpu::BufferMapAsyncStatus status) {
-        if (status == wgpu::BufferMapAsyncStatus::Success) {
-            const void* mappedData = readbackBuffer.getConstMappedRange(0, buffer_len * sizeof(float));
-            if (mappedData) {
-                memcpy(output.data(), mappedData, buffer_len * sizeof(float));
-                readbackBuffer.unmap();
-            } else {
-                std::cerr << "Failed to get mapped range!" << std::endl;
+static void prunePendingReadbacks(WebGPUContext& context) {
+    auto& pending = context.pendingReadbacks;
+    pending.erase(
+        std::remove_if(pending.begin(), pending.end(), [](const ReadbackTicket& ticket) { return ticket->ready; }),
+        pending.end()
+    );
+}
+
+static size_t acquireStagingSlot(WebGPUContext& context, uint64_t size) {
+    std::vector<StagingSlot>& ring = context.stagingRing;
+
+    // Prefer an idle slot that is already large enough, else grow an idle one.
+    // A full ring blocks until the GPU frees a slot instead of growing without bound.
+    size_t chosen = ring.size();
+    while (true) {
+        for (size_t i = 0; i < ring.size(); i++) {
+            if (ring[i].busy) continue;
+            if (ring[i].size >= size) {
+                chosen = i;
+                break;
             }
-        } else {
-            std::cerr << "Failed to map buffer! Status: " << int(status) << std::endl;
+            if (chosen == ring.size()) chosen = i;
         }
-        mappingComplete = true;
-    });
-
-    // Wait for the mapping to complete
-    while (!mappingComplete) {
-    #ifndef __EMSCRIPTEN__
-        wgpuDevicePoll(device, true, nullptr);
-    #else
-        emscripten_sleep(100); // Yield to browser event loop
-    #endif
+        if (chosen != ring.size() || ring.size() < maxStagingSlots) {
+            break;
+        }
+        waitForGpu(context);
+        prunePendingReadbacks(context);
+    }
+    if (chosen == ring.size()) {
+        ring.emplace_back();
     }
 
-    readbackBuffer.release();
-    commandBuffer.release();
-
-    return output;
+    StagingSlot& slot = ring[chosen];
+    if (slot.size < size) {
+        if (slot.buffer) slot.buffer.release();
+        wgpu::BufferDescriptor stagingDesc = {};
+        stagingDesc.size = size;
+        stagingDesc.usage = wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::MapRead;
+        slot.buffer = context.device.createBuffer(stagingDesc);
+        slot.size = size;
+    }
+    slot.busy = true;
+    return chosen;
 }
 
-// Temporary Fix for uint32_t types
-std::vector<uint32_t> readBackInt(wgpu::Device& device, wgpu::Queue& queue, size_t buffer_len, wgpu::Buffer& outputBuffer) {
-    std::vector<uint32_t> output(buffer_len);
+ReadbackTicket readBackAsync(WebGPUContext& context, wgpu::Buffer& outputBuffer, size_t size, ReadbackCallback onComplete) {
+    flushStream(context);
 
-    wgpu::BufferDescriptor readbackBufferDesc = {};
-    readbackBufferDesc.size = buffer_len * sizeof(uint32_t);
-    readbackBufferDesc.usage = wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::MapRead;
-    wgpu::Buffer readbackBuffer = device.createBuffer(readbackBufferDesc);
+    ReadbackTicket ticket = std::make_shared<ReadbackState>();
+    ticket->onComplete = std::move(onComplete);
+    ticket->slot = acquireStagingSlot(context, size);
+    wgpu::Buffer stagingBuffer = context.stagingRing[ticket->slot].buffer;
 
     wgpu::CommandEncoderDescriptor encoderDesc = {};
-    wgpu::CommandEncoder copyEncoder = device.createCommandEncoder(encoderDesc);
-    copyEncoder.copyBufferToBuffer(outputBuffer, 0, readbackBuffer, 0, buffer_len * sizeof(uint32_t));
-
+    wgpu::CommandEncoder copyEncoder = context.device.createCommandEncoder(encoderDesc);
+    copyEncoder.copyBufferToBuffer(outputBuffer, 0, stagingBuffer, 0, size);
     wgpu::CommandBuffer commandBuffer = copyEncoder.finish();
-    queue.submit(1, &commandBuffer);
+    context.queue.submit(1, &commandBuffer);
+    commandBuffer.release();
+    copyEncoder.release();
 
-    //MAPPING BACK TO CPU
-    bool mappingComplete = false;
-    auto handle = readbackBuffer.mapAsync(wgpu::MapMode::Read, 0, buffer_len * sizeof(uint32_t), [&](wgpu::BufferMapAsyncStatus status) {
+    // The state is kept alive by pendingReadbacks until the callback fires
+    ReadbackState* state = ticket.get();
+    WebGPUContext* owner = &context;
+    ticket->mapHandle = stagingBuffer.mapAsync(wgpu::MapMode::Read, 0, size, [state, owner, stagingBuffer, size](wgpu::BufferMapAsyncStatus status) mutable {
         if (status == wgpu::BufferMapAsyncStatus::Success) {
-            const void* mappedData = readbackBuffer.getConstMappedRange(0, buffer_len * sizeof(uint32_t));
+            const void* mappedData = stagingBuffer.getConstMappedRange(0, size);
             if (mappedData) {
-                memcpy(output.data(), mappedData, buffer_len * sizeof(uint32_t));
-                readbackBuffer.unmap();
+                state->data.resize(size);
+                memcpy(state->data.data(), mappedData, size);
             } else {
                 std::cerr << "Failed to get mapped range!" << std::endl;
+                state->failed = true;
             }
+            stagingBuffer.unmap();
         } else {
             std::cerr << "Failed to map buffer! Status: " << int(status) << std::endl;
+            state->failed = true;
+        }
+        owner->stagingRing[state->slot].busy = false;
+        state->ready = true;
+        if (state->onComplete && !state->failed) {
+            state->onComplete(state->data.data(), state->data.size());
         }
-        mappingComplete = true;
     });
 
-    // Wait for the mapping to complete
-    while (!mappingComplete) {
-    #ifndef __EMSCRIPTEN__
-        wgpuDevicePoll(device, true, nullptr);
-    #else
-        emscripten_sleep(100); // Yield to browser event loop
-    #endif
+    context.pendingReadbacks.push_back(ticket);
+    return ticket;
+}
+
+void pollReadbacks(WebGPUContext& context) {
+#ifndef __EMSCRIPTEN__
+    wgpuDevicePoll(context.device, false, nullptr);
+#endif
+    prunePendingReadbacks(context);
+}
+
+void waitForReadback(WebGPUContext& context, const ReadbackTicket& ticket) {
+    while (!ticket->ready) {
+        waitForGpu(context);
     }
+    prunePendingReadbacks(context);
+}
 
-    readbackBuffer.release();
-    commandBuffer.release();
+void waitForReadbacks(WebGPUContext& context) {
+    while (!context.pendingReadbacks.empty()) {
+        waitForGpu(context);
+        prunePendingReadbacks(context);
+    }
+}
+
+void releaseStagingRing(WebGPUContext& context) {
+    waitForReadbacks(context);
+    for (StagingSlot& slot : context.stagingRing) {
+        slot.buffer.release();
+    }
+    context.stagingRing.clear();
+}
+
+// RELEASING THE CONTEXT
+void releaseWebGPUContext(WebGPUContext& context) {
+    // Readbacks first: they wait for all submitted work, and plans hand their
+    // uniforms back to the pool, so the pool goes after them
+    releaseStagingRing(context);
+    releaseFFTPlans(context);
+    releasePropagators(context);
+    releaseTwiddleTables(context);
+    releaseBufferPool(context);
+    releasePipelineCache(context);
+
+    if (context.queue) {
+        context.queue.release();
+        context.queue = nullptr;
+    }
+    if (context.device) {
+        context.device.release();
+        context.device = nullptr;
+    }
+    if (context.adapter) {
+        context.adapter.release();
+        context.adapter = nullptr;
+    }
+    if (context.instance) {
+        context.instance.release();
+        context.instance = nullptr;
+    }
+}
+
+// READBACK RESULTS FROM GPU TO CPU
+std::vector<float> readBack(WebGPUContext& context, size_t buffer_len, wgpu::Buffer& outputBuffer) {
+    std::vector<float> output(buffer_len);
+    ReadbackTicket ticket = readBackAsync(context, outputBuffer, buffer_len * sizeof(float));
+    waitForReadback(context, ticket);
+    if (!ticket->failed) {
+        memcpy(output.data(), ticket->data.data(), buffer_len * sizeof(float));
+    }
+    return output;
+}
 
+// Temporary Fix for uint32_t types
+std::vector<uint32_t> readBackInt(WebGPUContext& context, size_t buffer_len, wgpu::Buffer& outputBuffer) {
+    std::vector<uint32_t> output(buffer_len);
+    ReadbackTicket ticket = readBackAsync(context, outputBuffer, buffer_len * sizeof(uint32_t));
+    waitForReadback(context, ticket);
+    if (!ticket->failed) {
+        memcpy(output.data(), ticket->data.data(), buffer_len * sizeof(uint32_t));
+    }
     return output;
-}
\ No newline at end of file
+}
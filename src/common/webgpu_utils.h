@@ -6,28 +6,244 @@
 #include <vector>
 #include <cstring>
 #include <iostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <functional>
+#include <memory>
+
+// Template constants substituted as {{NAME}} into a shader before compilation
+using ShaderConstants = std::vector<std::pair<std::string, std::string>>;
+
+// Compiled pipeline and the bind group layout it was built against
+struct CachedPipeline {
+    wgpu::ComputePipeline pipeline = nullptr;
+    wgpu::BindGroupLayout bindGroupLayout = nullptr;
+};
+
+struct PipelineCacheStats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t size = 0;
+};
+
+// Compute passes and copies recorded into one command encoder.
+// Kernels append to the context's stream; recorded work is submitted when the
+// outermost GpuStreamScope closes, or immediately if no scope is open.
+struct GpuStream {
+    wgpu::CommandEncoder encoder = nullptr;
+    wgpu::ComputePassEncoder pass = nullptr;
+    std::vector<wgpu::BindGroup> bindGroups; // released once submitted
+    int depth = 0;
+    size_t recordedCommands = 0;
+    size_t submits = 0;
+};
+
+// Recycled buffers grouped by (usage, size rounded up to the bucket granularity).
+// Buffers returned while commands are still being recorded are held back until
+// the stream is submitted, so queued writes never race pending reads.
+struct BufferPool {
+    std::unordered_map<uint64_t, std::vector<wgpu::Buffer>> freeBuffers;
+    std::vector<std::pair<uint64_t, wgpu::Buffer>> pendingReturns;
+    size_t allocations = 0;
+    size_t reuses = 0;
+    size_t liveBuffers = 0;
+    uint64_t liveBytes = 0;
+    uint64_t totalBytes = 0;
+    uint64_t peakBytes = 0;
+};
+
+struct BufferPoolStats {
+    size_t allocations = 0;
+    size_t reuses = 0;
+    size_t liveBuffers = 0;
+    uint64_t liveBytes = 0;
+    uint64_t peakBytes = 0;
+    double reuseRate = 0.0;
+};
+
+// Reusable MapRead staging buffers for readbacks
+struct StagingSlot {
+    wgpu::Buffer buffer = nullptr;
+    uint64_t size = 0;
+    bool busy = false;
+};
+
+// Invoked with the copied bytes once a readback's staging buffer is mapped
+using ReadbackCallback = std::function<void(const void* data, size_t size)>;
+
+struct ReadbackState {
+    std::vector<uint8_t> data;
+    bool ready = false;
+    bool failed = false;
+    size_t slot = 0;
+    ReadbackCallback onComplete;
+    std::unique_ptr<wgpu::BufferMapCallback> mapHandle;
+};
+using ReadbackTicket = std::shared_ptr<ReadbackState>;
+
+// Adapter and device properties captured once in initWebGPU
+struct DeviceCapabilities {
+    uint32_t maxWorkgroupSizeX = 0;
+    uint32_t maxWorkgroupSizeY = 0;
+    uint32_t maxWorkgroupSizeZ = 0;
+    uint32_t maxInvocationsPerWorkgroup = 0;
+    uint32_t maxWorkgroupsPerDimension = 0;
+    uint32_t maxWorkgroupStorageSize = 0;
+    uint64_t maxStorageBufferBindingSize = 0;
+    uint64_t maxBufferSize = 0;
+    uint32_t minStorageBufferOffsetAlignment = 0;
+    uint32_t minUniformBufferOffsetAlignment = 0;
+
+    // Square tile side for 2D kernels, min(maxWorkgroupSizeX/Y, sqrt(maxInvocationsPerWorkgroup))
+    uint32_t tileSize2D = 0;
+
+    std::vector<wgpu::FeatureName> features;
+    bool shaderF16 = false;
+
+    std::string adapterName;
+    std::string driverDescription;
+    uint32_t vendorID = 0;
+    uint32_t deviceID = 0;
+
+    bool hasFeature(wgpu::FeatureName feature) const;
+};
+
+// Launch shapes chosen per adapter by the autotuner (see tuning.h); zero and false
+// keep the built-in defaults derived from DeviceCapabilities
+struct TuningConfig {
+    uint32_t linearWorkgroupSize = 0; // elementwise kernels, linearLaunch
+    uint32_t tileSize2D = 0;          // 2D kernels and FFT transposes, gridLaunch
+    uint32_t fftThreadsPerLine = 0;   // cap on threads of the shared-memory Stockham kernel
+    bool fftRadix4 = false;           // merge pairs of radix-2 Stockham stages into radix 4
+
+    bool operator==(const TuningConfig& other) const {
+        return linearWorkgroupSize == other.linearWorkgroupSize && tileSize2D == other.tileSize2D
+            && fftThreadsPerLine == other.fftThreadsPerLine && fftRadix4 == other.fftRadix4;
+    }
+};
+
+// Storage precision of complex field buffers. F16 halves their memory and bandwidth;
+// kernels still compute in f32 registers and convert on load and store. F16 needs
+// capabilities.shaderF16.
+enum class FieldStorage { F32, F16 };
+
+// Bytes of len complex values stored at the given precision
+inline uint64_t fieldBytes(FieldStorage storage, size_t len) {
+    return (storage == FieldStorage::F16 ? 2 * sizeof(uint16_t) : 2 * sizeof(float)) * len;
+}
+
+// Workgroup size and dispatch grid for one kernel launch.
+// Linear launches that exceed maxWorkgroupsPerDimension spill into Y; shaders
+// recover the flat index as global_id.x + global_id.y * num_workgroups.x * WORKGROUP_SIZE_X.
+struct LaunchConfig {
+    uint32_t workgroupSizeX = 1;
+    uint32_t workgroupSizeY = 1;
+    uint32_t workgroupsX = 1;
+    uint32_t workgroupsY = 1;
+    uint32_t workgroupsZ = 1;
+};
+
+// Pre-built FFT, see fft/fft_plan.h
+class FFTPlan;
 
 struct WebGPUContext {
     wgpu::Instance instance = nullptr;
     wgpu::Adapter adapter = nullptr;
     wgpu::Device device = nullptr;
     wgpu::Queue queue = nullptr;
+    DeviceCapabilities capabilities;
+    TuningConfig tuning; // loaded from the tuning file in initWebGPU when present
+    FieldStorage fieldStorage = FieldStorage::F32; // storage of the forward models' fields, see setFieldStorage
+
+    // Pipelines keyed by (shader, workgroup size, constants), owned by the context
+    std::unordered_map<std::string, CachedPipeline> pipelineCache;
+    size_t pipelineCacheHits = 0;
+    size_t pipelineCacheMisses = 0;
+
+    GpuStream stream;
+    BufferPool bufferPool;
+
+    // FFT/DFT twiddle and Bluestein tables keyed by (kind, length, direction), see fft/twiddle.h
+    std::unordered_map<uint64_t, wgpu::Buffer> twiddleTables;
+    // SSNP propagator, kz and pupil tables keyed by (kind, shape, res, dz or na), see ssnp/propagator/propagator.h
+    std::unordered_map<std::string, wgpu::Buffer> propagators;
+    // FFT plans keyed by shape, direction and placement; declared after bufferPool so they release first
+    std::unordered_map<std::string, std::shared_ptr<FFTPlan>> fftPlans;
+
+    // Staging ring and readbacks whose map callback has not fired yet
+    std::vector<StagingSlot> stagingRing;
+    std::vector<ReadbackTicket> pendingReadbacks;
+};
+
+// Pool-owned buffer handle; returns the buffer to the context's pool when destroyed
+class PooledBuffer {
+public:
+    PooledBuffer() = default;
+    PooledBuffer(WebGPUContext& context, wgpu::Buffer buffer, uint64_t key, uint64_t size);
+    ~PooledBuffer();
+
+    PooledBuffer(PooledBuffer&& other) noexcept;
+    PooledBuffer& operator=(PooledBuffer&& other) noexcept;
+    PooledBuffer(const PooledBuffer&) = delete;
+    PooledBuffer& operator=(const PooledBuffer&) = delete;
+
+    wgpu::Buffer& get() { return buffer; }
+    const wgpu::Buffer& get() const { return buffer; }
+    operator wgpu::Buffer&() { return buffer; }
+    operator const wgpu::Buffer&() const { return buffer; }
+    explicit operator bool() const { return buffer != nullptr; }
+    uint64_t size() const { return bytes; }
+
+    // Hands the buffer back to the pool early
+    void reset();
+
+private:
+    WebGPUContext* context = nullptr;
+    wgpu::Buffer buffer = nullptr;
+    uint64_t key = 0;
+    uint64_t bytes = 0;
 };
 
-struct WorkgroupLimits {
-    double maxWorkgroupSizeX;
-    double maxWorkgroupSizeY;
-    double maxWorkgroupSizeZ;
-    double maxInvocationsPerWorkgroup;
+// Buffer bound from a byte offset, e.g. one slice of a GpuVolume; converts from whole buffers
+struct BufferView {
+    wgpu::Buffer buffer = nullptr;
+    uint64_t offset = 0;
+
+    BufferView() = default;
+    BufferView(const wgpu::Buffer& source, uint64_t byteOffset = 0) : buffer(source), offset(byteOffset) {}
+    BufferView(const PooledBuffer& source, uint64_t byteOffset = 0) : buffer(source.get()), offset(byteOffset) {}
 };
 
-// Initializes WebGPU
+// Initializes WebGPU and loads this adapter's tuning, if any
 void initWebGPU(WebGPUContext& context);
 
-WorkgroupLimits getWorkgroupLimits(wgpu::Device& device);
+// Launch configurations derived from the context's DeviceCapabilities.
+// linearLaunch covers `invocations` threads with 1D workgroups; groupLaunch runs
+// one workgroup of up to `workgroupSize` threads per item (shaders recover the item
+// as workgroup_id.x + workgroup_id.y * num_workgroups.x); gridLaunch covers
+// a cols x rows grid with square 2D tiles.
+LaunchConfig linearLaunch(const WebGPUContext& context, size_t invocations);
+LaunchConfig groupLaunch(const WebGPUContext& context, size_t groups, uint32_t workgroupSize);
+LaunchConfig gridLaunch(const WebGPUContext& context, uint32_t cols, uint32_t rows);
 
-// Reads shader source code from a file
-std::string readShaderFile(const std::string& filename, int workgroupsX = 256, int workgroupsY = 1, int workgroupsZ = 1);
+// Selects the storage precision of the forward models' fields and returns the one in
+// effect: F16 falls back to F32 on adapters without shader-f16
+FieldStorage setFieldStorage(WebGPUContext& context, FieldStorage storage);
+
+// Template constants for precision-templated kernels: {{FIELD_IN}} and {{FIELD_OUT}}
+// are the element types of their input and output fields and {{ENABLE_F16}} the
+// directive f16 storage needs. Shaders compiled without them get f32 fields.
+ShaderConstants fieldStorageConstants(FieldStorage input, FieldStorage output);
+
+// Returns the embedded source for a shader (by its path from the repo root) with templates filled in
+std::string readShaderFile(
+    const std::string& filename,
+    int workgroupsX = 256,
+    int workgroupsY = 1,
+    int workgroupsZ = 1,
+    const ShaderConstants& constants = {}
+);
 
 // Creates a WebGPU shader module from WGSL source code
 wgpu::ShaderModule createShaderModule(wgpu::Device& device, const std::string& shaderCode);
@@ -35,21 +251,120 @@ wgpu::ShaderModule createShaderModule(wgpu::Device& device, const std::string& s
 // Creates a WebGPU buffer
 wgpu::Buffer createBuffer(wgpu::Device& device, const void* data, size_t size, wgpu::BufferUsage usage);
 
+// Buffer pool utilities. Recycled buffers are not cleared, so their contents are undefined unless data is given.
+PooledBuffer acquireBuffer(
+    WebGPUContext& context,
+    const void* data,
+    size_t size,
+    wgpu::BufferUsage usage = WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
+);
+BufferPoolStats getBufferPoolStats(const WebGPUContext& context);
+void releaseBufferPool(WebGPUContext& context);
+
+// Idle pool bytes kept across runs by trimBufferPool
+constexpr uint64_t defaultPoolIdleBytes = 64ull * 1024 * 1024;
+
+// Releases idle pool buffers, largest buckets first, until at most maxIdleBytes stay
+// free for reuse. The forward and inverse models call it at the end of each run.
+void trimBufferPool(WebGPUContext& context, uint64_t maxIdleBytes = defaultPoolIdleBytes);
+
 // Compute pipeline utilities
 wgpu::ComputePipeline createComputePipeline(wgpu::Device& device, wgpu::ShaderModule shaderModule, wgpu::BindGroupLayout bindGroupLayout);
 
-// Create command buffer
-wgpu::CommandBuffer createComputeCommandBuffer(
-    wgpu::Device& device,
-    wgpu::ComputePipeline& computePipeline,
-    wgpu::BindGroup& bindGroup,
+// Returns the cached pipeline for a shader, compiling it (and its layout) on first use.
+// The context owns the returned objects; callers must not release them.
+CachedPipeline getComputePipeline(
+    WebGPUContext& context,
+    const std::string& shaderFile,
+    wgpu::BindGroupLayout (*createLayout)(wgpu::Device&),
+    int workgroupsX = 256,
+    int workgroupsY = 1,
+    int workgroupsZ = 1,
+    const ShaderConstants& constants = {}
+);
+
+PipelineCacheStats getPipelineCacheStats(const WebGPUContext& context);
+void releasePipelineCache(WebGPUContext& context);
+
+// Command recording
+void beginStream(WebGPUContext& context);
+void endStream(WebGPUContext& context);
+void flushStream(WebGPUContext& context);
+
+// Opens a recording scope for its lifetime; nested scopes submit with the outermost one
+struct GpuStreamScope {
+    explicit GpuStreamScope(WebGPUContext& context) : context(context) { beginStream(context); }
+    ~GpuStreamScope() { endStream(context); }
+    GpuStreamScope(const GpuStreamScope&) = delete;
+    GpuStreamScope& operator=(const GpuStreamScope&) = delete;
+
+    WebGPUContext& context;
+};
+
+// Records a dispatch into the context's stream; the stream takes ownership of the bind group
+void dispatchCompute(
+    WebGPUContext& context,
+    const wgpu::ComputePipeline& computePipeline,
+    wgpu::BindGroup bindGroup,
     uint32_t workgroupsX,
     uint32_t workgroupsY = 1,
     uint32_t workgroupsZ = 1
 );
+void dispatchCompute(
+    WebGPUContext& context,
+    const wgpu::ComputePipeline& computePipeline,
+    wgpu::BindGroup bindGroup,
+    const LaunchConfig& launch
+);
+
+// Records a buffer copy into the context's stream
+void copyBufferToBuffer(
+    WebGPUContext& context,
+    const wgpu::Buffer& source,
+    uint64_t sourceOffset,
+    const wgpu::Buffer& destination,
+    uint64_t destinationOffset,
+    uint64_t size
+);
+
+// Records a zero fill of a buffer range into the context's stream
+void clearBuffer(
+    WebGPUContext& context,
+    const wgpu::Buffer& buffer,
+    uint64_t offset,
+    uint64_t size
+);
+
+// Asynchronous readback through the staging ring. Submits any recorded work
+// first so the copy sees its results; the callback runs from a poll or wait.
+// When every slot of the bounded ring is in flight, blocks until one lands.
+ReadbackTicket readBackAsync(
+    WebGPUContext& context,
+    wgpu::Buffer& outputBuffer,
+    size_t size,
+    ReadbackCallback onComplete = nullptr
+);
+void pollReadbacks(WebGPUContext& context);
+void waitForReadback(WebGPUContext& context, const ReadbackTicket& ticket);
+void waitForReadbacks(WebGPUContext& context);
+void releaseStagingRing(WebGPUContext& context);
+
+// Frees everything the context owns: staging ring, FFT plans, SSNP propagators,
+// twiddle tables, buffer pool and pipeline cache, then the device itself.
+// Buffers still held by callers must be released first.
+void releaseWebGPUContext(WebGPUContext& context);
+
+// Releases the context when the scope exits, including by an exception
+struct ContextGuard {
+    WebGPUContext& context;
+    explicit ContextGuard(WebGPUContext& context) : context(context) {}
+    ~ContextGuard() { releaseWebGPUContext(context); }
+    ContextGuard(const ContextGuard&) = delete;
+    ContextGuard& operator=(const ContextGuard&) = delete;
+};
 
-// Readback from GPU to CPU
-std::vector<float> readBack(wgpu::Device& device, wgpu::Queue& queue, size_t buffer_len, wgpu::Buffer& outputBuffer);
-std::vector<uint32_t> readBackInt(wgpu::Device& device, wgpu::Queue& queue, size_t buffer_len, wgpu::Buffer& outputBuffer);
+// Blocking readback from GPU to CPU
+std::vector<float> readBack(WebGPUContext& context, size_t buffer_len, wgpu::Buffer& outputBuffer);
+std::vector<uint32_t> readBackInt(WebGPUContext& context, size_t buffer_len, wgpu::Buffer& outputBuffer);
 
 #endif
\ No newline at end of file
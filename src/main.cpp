@@ -5,6 +5,7 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace std;
@@ -23,6 +24,7 @@ int main(int argc, char* argv[]) {
 
     // INITIALIZING WEBGPU
     WebGPUContext context;
+    ContextGuard contextGuard(context);
     initWebGPU(context);
 
     if (model_type == "ssnp_reconstruct") {
@@ -41,7 +43,7 @@ int main(int argc, char* argv[]) {
             context,
             input.measured,
             input.angles,
-            input.initial_volume,
+            std::move(input.initial_volume),
             input.res,
             input.na,
             input.n0,
@@ -52,7 +54,7 @@ int main(int argc, char* argv[]) {
         return 0;
     }
 
-    vector<vector<vector<float>>> input_tensor;
+    Tensor3D input_tensor;
     int D, H, W;
 
     if (!testing_io::read_input_tensor(input_filename, input_tensor, D, H, W)) return 1;
@@ -87,6 +89,9 @@ EM_JS(void, plot_complex_from_heap, (uintptr_t ptr, int len, int H, int W, float
 extern "C" {
     EMSCRIPTEN_KEEPALIVE
     void callModel(const char* model, uintptr_t dataPtr, int D, int H, int W, const char* paramsStr) {
+        // Each call builds its own context; its caches and device are freed on the way out
+        WebGPUContext context;
+        ContextGuard contextGuard(context);
         try {
             // Parse params
             std::string fullInput(paramsStr);
@@ -126,15 +131,9 @@ extern "C" {
 
             // Read data from heap & convert to 3D tensor
             float* heapData = reinterpret_cast<float*>(dataPtr);
-            vector<vector<vector<float>>> tensor(D, vector<vector<float>>(H, vector<float>(W)));
-            size_t idx = 0;
-            for (int d = 0; d < D; ++d)
-                for (int i = 0; i < H; ++i)
-                    for (int j = 0; j < W; ++j)
-                        tensor[d][i][j] = heapData[idx++];
+            Tensor3D tensor = Tensor3D::fromData(heapData, D, H, W);
 
             // Init WebGPU
-            WebGPUContext context;
             initWebGPU(context);
 
             // Pass n0 to forward function
@@ -142,8 +141,8 @@ extern "C" {
             
             // Complex output
             if (outputType == 2) {
-                auto realPart = result[0];
-                auto imagPart = result[1];
+                Tensor2DView realPart = result.slice(0);
+                Tensor2DView imagPart = result.slice(1);
                 
                 size_t N = (size_t)H * (size_t)W;
                 float* complexOut = (float*)malloc(sizeof(float) * N * 2);
@@ -154,8 +153,8 @@ extern "C" {
                 
                 for (int i = 0; i < H; ++i) {
                     for (int j = 0; j < W; ++j) {
-                        float real = realPart[i][j];
-                        float imag = imagPart[i][j];
+                        float real = realPart(i, j);
+                        float imag = imagPart(i, j);
                         float mag = sqrt(real*real + imag*imag);
                         float phase = atan2(imag, real);
                         
@@ -176,17 +175,17 @@ extern "C" {
             
             // Amplitude/Intensity outputs
             else {
-                auto output = result[0];
+                Tensor2DView output = result.slice(0);
                 
                 size_t N = (size_t)H * (size_t)W;
                 float* out = (float*)malloc(sizeof(float) * N);
                 size_t k = 0;
 
-                float localMin = output[0][0];
-                float localMax = output[0][0];
+                float localMin = output(0, 0);
+                float localMax = output(0, 0);
                 for (int i = 0; i < H; ++i) {
                     for (int j = 0; j < W; ++j) {
-                        float v = output[i][j];
+                        float v = output(i, j);
                         out[k++] = v;
                         if (v < localMin) localMin = v;
                         if (v > localMax) localMax = v;
@@ -6,13 +6,13 @@ std::map<std::string, ModelFunction> model_registry = {
     {"born", born::forward}
 };
 
-std::vector<std::vector<std::vector<float>>> dispatch_model(
+Tensor3D dispatch_model(
     const std::string& model_name,
     WebGPUContext& context,
-    std::vector<std::vector<std::vector<float>>> n,
-    std::vector<float> res,
+    const Tensor3D& n,
+    const std::vector<float>& res,
     float na,
-    std::vector<std::vector<float>> angles,
+    const std::vector<std::vector<float>>& angles,
     float n0,
     int outputType
 ) {
@@ -9,23 +9,23 @@
 #include <string>
 #include <map>
 
-typedef std::vector<std::vector<std::vector<float>>> (*ModelFunction)(
+typedef Tensor3D (*ModelFunction)(
     WebGPUContext&, 
-    std::vector<std::vector<std::vector<float>>>, 
-    std::vector<float>, 
+    const Tensor3D&, 
+    const std::vector<float>&, 
     float, 
-    std::vector<std::vector<float>>, 
+    const std::vector<std::vector<float>>&, 
     float, 
     int
 );
 
-std::vector<std::vector<std::vector<float>>> dispatch_model(
+Tensor3D dispatch_model(
     const std::string& model_name,
     WebGPUContext& context,
-    std::vector<std::vector<std::vector<float>>> n,
-    std::vector<float> res,
+    const Tensor3D& n,
+    const std::vector<float>& res,
     float na,
-    std::vector<std::vector<float>> angles,
+    const std::vector<std::vector<float>>& angles,
     float n0,
     int outputType
 );
@@ -1,13 +1,6 @@
 #include "diffract_grad.h"
 #include <cmath>
 
-struct Params {
-    float dz;
-};
-
-static size_t buffer_len;
-static size_t res_buffer_len;
-
 // CREATING BIND GROUP AND LAYOUT
 static wgpu::BindGroupLayout createBindGroupLayout(wgpu::Device& device) {
     wgpu::BindGroupLayoutEntry ufBufferLayout = {};
@@ -20,35 +13,25 @@ static wgpu::BindGroupLayout createBindGroupLayout(wgpu::Device& device) {
     ubBufferLayout.visibility = wgpu::ShaderStage::Compute;
     ubBufferLayout.buffer.type = wgpu::BufferBindingType::ReadOnlyStorage;
 
-    wgpu::BindGroupLayoutEntry resBufferLayout = {};
-    resBufferLayout.binding = 2;
-    resBufferLayout.visibility = wgpu::ShaderStage::Compute;
-    resBufferLayout.buffer.type = wgpu::BufferBindingType::ReadOnlyStorage;
-
-    wgpu::BindGroupLayoutEntry cgammaBufferLayout = {};
-    cgammaBufferLayout.binding = 3;
-    cgammaBufferLayout.visibility = wgpu::ShaderStage::Compute;
-    cgammaBufferLayout.buffer.type = wgpu::BufferBindingType::ReadOnlyStorage;
+    wgpu::BindGroupLayoutEntry propagatorBufferLayout = {};
+    propagatorBufferLayout.binding = 2;
+    propagatorBufferLayout.visibility = wgpu::ShaderStage::Compute;
+    propagatorBufferLayout.buffer.type = wgpu::BufferBindingType::ReadOnlyStorage;
 
     wgpu::BindGroupLayoutEntry newUFBufferLayout = {};
-    newUFBufferLayout.binding = 4;
+    newUFBufferLayout.binding = 3;
     newUFBufferLayout.visibility = wgpu::ShaderStage::Compute;
     newUFBufferLayout.buffer.type = wgpu::BufferBindingType::Storage;
 
     wgpu::BindGroupLayoutEntry newUBBufferLayout = {};
-    newUBBufferLayout.binding = 5;
+    newUBBufferLayout.binding = 4;
     newUBBufferLayout.visibility = wgpu::ShaderStage::Compute;
     newUBBufferLayout.buffer.type = wgpu::BufferBindingType::Storage;
 
-    wgpu::BindGroupLayoutEntry uniformBufferLayout = {};
-    uniformBufferLayout.binding = 6;
-    uniformBufferLayout.visibility = wgpu::ShaderStage::Compute;
-    uniformBufferLayout.buffer.type = wgpu::BufferBindingType::Uniform;
-
-    wgpu::BindGroupLayoutEntry entries[] = {ufBufferLayout, ubBufferLayout, resBufferLayout, cgammaBufferLayout, newUFBufferLayout, newUBBufferLayout, uniformBufferLayout};
+    wgpu::BindGroupLayoutEntry entries[] = {ufBufferLayout, ubBufferLayout, propagatorBufferLayout, newUFBufferLayout, newUBBufferLayout};
 
     wgpu::BindGroupLayoutDescriptor layoutDesc = {};
-    layoutDesc.entryCount = 7;
+    layoutDesc.entryCount = 5;
     layoutDesc.entries = entries;
 
     return device.createBindGroupLayout(layoutDesc);
@@ -60,11 +43,11 @@ static wgpu::BindGroup createBindGroup(
     wgpu::BindGroupLayout bindGroupLayout,
     wgpu::Buffer ufBuffer,
     wgpu::Buffer ubBuffer,
-    wgpu::Buffer resBuffer,
-    wgpu::Buffer cgammaBuffer,
+    wgpu::Buffer propagatorBuffer,
     wgpu::Buffer newUFBuffer,
     wgpu::Buffer newUBBuffer,
-    wgpu::Buffer uniformBuffer
+    size_t buffer_len,
+    size_t field_len
 ) {
     wgpu::BindGroupEntry ufEntry = {};
     ufEntry.binding = 0;
@@ -78,41 +61,29 @@ static wgpu::BindGroup createBindGroup(
     ubEntry.offset = 0;
     ubEntry.size = sizeof(float) * 2 * buffer_len;
 
-    wgpu::BindGroupEntry resEntry = {};
-    resEntry.binding = 2;
-    resEntry.buffer = resBuffer;
-    resEntry.offset = 0;
-    resEntry.size = sizeof(float) * res_buffer_len;
-
-    wgpu::BindGroupEntry cgammaEntry = {};
-    cgammaEntry.binding = 3;
-    cgammaEntry.buffer = cgammaBuffer;
-    cgammaEntry.offset = 0;
-    cgammaEntry.size = sizeof(float) * buffer_len;
+    wgpu::BindGroupEntry propagatorEntry = {};
+    propagatorEntry.binding = 2;
+    propagatorEntry.buffer = propagatorBuffer;
+    propagatorEntry.offset = 0;
+    propagatorEntry.size = sizeof(float) * 4 * field_len;
 
     wgpu::BindGroupEntry newUFEntry = {};
-    newUFEntry.binding = 4;
+    newUFEntry.binding = 3;
     newUFEntry.buffer = newUFBuffer;
     newUFEntry.offset = 0;
     newUFEntry.size = sizeof(float) * 2 * buffer_len;
 
     wgpu::BindGroupEntry newUBEntry = {};
-    newUBEntry.binding = 5;
+    newUBEntry.binding = 4;
     newUBEntry.buffer = newUBBuffer;
     newUBEntry.offset = 0;
     newUBEntry.size = sizeof(float) * 2 * buffer_len;
 
-    wgpu::BindGroupEntry uniformEntry = {};
-    uniformEntry.binding = 6;
-    uniformEntry.buffer = uniformBuffer;
-    uniformEntry.offset = 0;
-    uniformEntry.size = sizeof(Params);
-
-    wgpu::BindGroupEntry entries[] = {ufEntry, ubEntry, resEntry, cgammaEntry, newUFEntry, newUBEntry, uniformEntry};
+    wgpu::BindGroupEntry entries[] = {ufEntry, ubEntry, propagatorEntry, newUFEntry, newUBEntry};
 
     wgpu::BindGroupDescriptor bindGroupDesc = {};
     bindGroupDesc.layout = bindGroupLayout;
-    bindGroupDesc.entryCount = 7;
+    bindGroupDesc.entryCount = 5;
     bindGroupDesc.entries = entries;
 
     return device.createBindGroup(bindGroupDesc);
@@ -129,40 +100,23 @@ void diffract_grad(
     std::optional<std::vector<float>> res,
     std::optional<float> dz
 ) {
-    buffer_len = bufferlen;
-    res_buffer_len = res.value().size();
-    Params params = {dz.value()};
+    size_t buffer_len = bufferlen;
+    size_t field_len = size_t(shape[0]) * shape[1];
 
     // INITIALIZING WEBGPU
     wgpu::Device device = context.device;
-    wgpu::Queue queue = context.queue;
 
     // LOADING AND COMPILING SHADER CODE
-    WorkgroupLimits limits = getWorkgroupLimits(device);
-    std::string shaderCode = readShaderFile("src/ssnp/diffract_grad/diffract_grad.wgsl", limits.maxWorkgroupSizeX);
-    wgpu::ShaderModule shaderModule = createShaderModule(device, shaderCode);
+    LaunchConfig launch = linearLaunch(context, buffer_len);
+    CachedPipeline cached = getComputePipeline(context, "src/ssnp/diffract_grad/diffract_grad.wgsl", createBindGroupLayout, launch.workgroupSizeX);
 
-    wgpu::Buffer cgammaBuffer = createBuffer(context.device, nullptr, sizeof(float) * buffer_len, WGPUBufferUsage(wgpu::BufferUsage::Storage));
-    c_gamma(context, cgammaBuffer, res.value(), shape);
-    wgpu::Buffer resBuffer = createBuffer(device, res.value().data(), sizeof(float) * res_buffer_len, wgpu::BufferUsage::Storage);
-    wgpu::Buffer uniformBuffer = createBuffer(device, &params, sizeof(Params), wgpu::BufferUsage::Uniform);
+    // the same propagator as the forward step, applied transposed
+    wgpu::Buffer propagatorBuffer = getPropagator(context, shape, res.value(), dz.value());
 
-    wgpu::BindGroupLayout bindGroupLayout = createBindGroupLayout(device);
-    wgpu::BindGroup bindGroup = createBindGroup(device, bindGroupLayout, ufBuffer, ubBuffer, resBuffer, cgammaBuffer, newUFBuffer, newUBBuffer, uniformBuffer);
+    wgpu::BindGroupLayout bindGroupLayout = cached.bindGroupLayout;
+    wgpu::BindGroup bindGroup = createBindGroup(device, bindGroupLayout, ufBuffer, ubBuffer, propagatorBuffer, newUFBuffer, newUBBuffer, buffer_len, field_len);
 
     // ENCODING AND DISPATCHING COMPUTE COMMANDS
-    wgpu::ComputePipeline computePipeline = createComputePipeline(device, shaderModule, bindGroupLayout);
-    uint32_t workgroupsX = std::ceil(double(buffer_len) / limits.maxWorkgroupSizeX);
-    wgpu::CommandBuffer commandBuffer = createComputeCommandBuffer(device, computePipeline, bindGroup, workgroupsX);
-    queue.submit(1, &commandBuffer);
-
-    // RELEASE RESOURCES
-    commandBuffer.release();
-    computePipeline.release();
-    bindGroup.release();
-    bindGroupLayout.release();
-    shaderModule.release();
-    cgammaBuffer.release();
-    resBuffer.release();
-    uniformBuffer.release();
+    wgpu::ComputePipeline computePipeline = cached.pipeline;
+    dispatchCompute(context, computePipeline, bindGroup, launch);
 }
@@ -2,7 +2,7 @@
 #define SSNP_DIFFRACT_GRAD_H
 
 #include "../../common/webgpu_utils.h"
-#include "../../common/c_gamma/c_gamma.h"
+#include "../propagator/propagator.h"
 #include <optional>
 #include <vector>
 
@@ -1,41 +1,21 @@
 @group(0) @binding(0) var<storage, read> uf: array<vec2<f32>>;
 @group(0) @binding(1) var<storage, read> ub: array<vec2<f32>>;
-@group(0) @binding(2) var<storage, read> res: array<f32>;
-@group(0) @binding(3) var<storage, read> cgamma: array<f32>;
-@group(0) @binding(4) var<storage, read_write> newUF: array<vec2<f32>>;
-@group(0) @binding(5) var<storage, read_write> newUB: array<vec2<f32>>;
-@group(0) @binding(6) var<uniform> params: f32;
+@group(0) @binding(2) var<storage, read> propagator: array<vec4<f32>>; // (P00, P01, P10, P11) per pixel of one field
+@group(0) @binding(3) var<storage, read_write> newUF: array<vec2<f32>>;
+@group(0) @binding(4) var<storage, read_write> newUB: array<vec2<f32>>;
 
+// Adjoint of ssnp_diffract: P is real, so its adjoint is the transpose
 @compute @workgroup_size({{WORKGROUP_SIZE}})
-fn main(@builtin(global_invocation_id) global_id: vec3<u32>) {
-    let idx = global_id.x;
+fn main(@builtin(global_invocation_id) global_id: vec3<u32>, @builtin(num_workgroups) num_groups: vec3<u32>) {
+    let idx = global_id.x + global_id.y * num_groups.x * {{WORKGROUP_SIZE_X}}u;
     if (idx >= arrayLength(&uf)) {
         return;
     }
 
-    let pi = radians(180.0);
-    let gamma = cgamma[idx];
-    let kz = 2.0 * pi * res[0] * gamma;
+    let p = propagator[idx % arrayLength(&propagator)];
+    let uf_value = uf[idx];
+    let ub_value = ub[idx];
 
-    let exponent = clamp((gamma - 0.2) * 5.0, -60.0, 0.0);
-    let eva = exp(exponent);
-    let kz_dz = kz * params;
-
-    let cos_kz_dz = cos(kz_dz) * eva;
-    let sin_kz_dz = select(sin(kz_dz), kz_dz - (kz_dz * kz_dz * kz_dz) / 6.0, abs(kz_dz) < 1e-2) * eva;
-
-    let p_mat_0 = cos_kz_dz;
-    let p_mat_1 = -sin_kz_dz * kz;
-    let p_mat_2 = sin_kz_dz / max(kz, 1e-6);
-    let p_mat_3 = cos_kz_dz;
-
-    newUF[idx] = vec2<f32>(
-        p_mat_0 * uf[idx].x + p_mat_1 * ub[idx].x,
-        p_mat_0 * uf[idx].y + p_mat_1 * ub[idx].y
-    );
-
-    newUB[idx] = vec2<f32>(
-        p_mat_2 * uf[idx].x + p_mat_3 * ub[idx].x,
-        p_mat_2 * uf[idx].y + p_mat_3 * ub[idx].y
-    );
+    newUF[idx] = p.x * uf_value + p.z * ub_value;
+    newUB[idx] = p.y * uf_value + p.w * ub_value;
 }
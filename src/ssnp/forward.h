@@ -10,12 +10,12 @@ using namespace std;
 
 namespace ssnp {
 
-    vector<vector<vector<float>>> forward(
+    Tensor3D forward(
         WebGPUContext& context, 
-        vector<vector<vector<float>>> n, 
-        vector<float> res, 
+        const Tensor3D& n, 
+        const vector<float>& res, 
         float na, 
-        vector<vector<float>> angles, 
+        const vector<vector<float>>& angles, 
         float n0,
         int outputType
     );
@@ -15,20 +15,17 @@ struct AngleGradientResult {
     float loss = 0.0f;
 };
 
-wgpu::Buffer make_real_buffer(WebGPUContext& context, size_t buffer_len);
+PooledBuffer make_real_buffer(WebGPUContext& context, size_t buffer_len);
 
 // COMPUTING THE PER-ANGLE MSE LOSS
 float mean_squared_loss(
     const std::vector<float>& predicted,
-    const std::vector<std::vector<float>>& measured
+    Tensor2DView measured
 ) {
     float loss = 0.0f;
-    size_t width = measured[0].size();
     for (size_t i = 0; i < predicted.size(); ++i) {
-        size_t row = i / width;
-        size_t col = i % width;
         float pred_amp = std::sqrt(predicted[i] + 1e-8f);
-        float meas_amp = std::sqrt(measured[row][col] + 1e-8f);
+        float meas_amp = std::sqrt(measured.data()[i] + 1e-8f);
         float residual = pred_amp - meas_amp;
         loss += residual * residual;
     }
@@ -38,8 +35,8 @@ float mean_squared_loss(
 // COMPUTING THE FORWARD LOSS FOR ONE ANGLE
 float compute_angle_loss(
     WebGPUContext& context,
-    const std::vector<std::vector<std::vector<float>>>& volume,
-    const std::vector<std::vector<float>>& measured,
+    const GpuVolume& volume,
+    Tensor2DView measured,
     const std::vector<float>& angle,
     const std::vector<int>& shape,
     const std::vector<float>& res,
@@ -56,26 +53,25 @@ float compute_angle_loss(
         n0
     );
 
-    wgpu::Buffer field_buffer = project_state_to_sensor_field(
+    PooledBuffer field_buffer = project_state_to_sensor_field(
         context,
         exit_state,
         shape,
         res,
         na,
-        -static_cast<float>(volume.size()) / 2.0f
+        -static_cast<float>(volume.depth) / 2.0f
     );
 
-    wgpu::Buffer predicted_intensity_buffer = make_real_buffer(context, buffer_len);
+    PooledBuffer predicted_intensity_buffer = make_real_buffer(context, buffer_len);
     intense(context, predicted_intensity_buffer, field_buffer, buffer_len, true);
     std::vector<float> predicted_intensity = readBack(
-        context.device,
-        context.queue,
+        context,
         buffer_len,
         predicted_intensity_buffer
     );
 
-    predicted_intensity_buffer.release();
-    field_buffer.release();
+    predicted_intensity_buffer.reset();
+    field_buffer.reset();
     release_state(exit_state);
 
     return mean_squared_loss(predicted_intensity, measured);
@@ -84,8 +80,8 @@ float compute_angle_loss(
 // COMPUTING THE AVERAGE MEASUREMENT LOSS FOR THE CURRENT VOLUME
 float compute_measurement_loss(
     WebGPUContext& context,
-    const std::vector<std::vector<std::vector<float>>>& volume,
-    const std::vector<std::vector<std::vector<float>>>& measured,
+    const GpuVolume& volume,
+    const Tensor3D& measured,
     const std::vector<std::vector<float>>& angles,
     const std::vector<int>& shape,
     const std::vector<float>& res,
@@ -98,7 +94,7 @@ float compute_measurement_loss(
         total_loss += compute_angle_loss(
             context,
             volume,
-            measured[angle_idx],
+            measured.slice(angle_idx),
             angles[angle_idx],
             shape,
             res,
@@ -115,37 +111,22 @@ float amplitude_mse_from_loss(float loss) {
     return 2.0f * loss;
 }
 
-// CREATING A ZERO-INITIALIZED GRADIENT VOLUME
-std::vector<std::vector<std::vector<float>>> zeros_like(
-    const std::vector<std::vector<std::vector<float>>>& volume
-) {
-    return std::vector<std::vector<std::vector<float>>>(
-        volume.size(),
-        std::vector<std::vector<float>>(
-            volume[0].size(),
-            std::vector<float>(volume[0][0].size(), 0.0f)
-        )
-    );
-}
-
 // ACCUMULATING A FLAT SLICE INTO THE 3D GRADIENT VOLUME
 void accumulate_slice(
-    std::vector<std::vector<std::vector<float>>>& grad_volume,
+    Tensor3D& grad_volume,
     size_t z,
     const std::vector<float>& flat_slice
 ) {
-    size_t width = grad_volume[z][0].size();
-    for (size_t row = 0; row < grad_volume[z].size(); ++row) {
-        for (size_t col = 0; col < width; ++col) {
-            grad_volume[z][row][col] += flat_slice[row * width + col];
-        }
+    float* grad_slice = grad_volume.sliceData(z);
+    for (size_t i = 0; i < grad_volume.sliceSize(); ++i) {
+        grad_slice[i] += flat_slice[i];
     }
 }
 
 // CREATING COMPLEX TEMPORARY BUFFERS
-wgpu::Buffer make_complex_buffer(WebGPUContext& context, size_t buffer_len) {
-    return createBuffer(
-        context.device,
+PooledBuffer make_complex_buffer(WebGPUContext& context, size_t buffer_len) {
+    return acquireBuffer(
+        context,
         nullptr,
         sizeof(float) * buffer_len * 2,
         WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
@@ -153,9 +134,9 @@ wgpu::Buffer make_complex_buffer(WebGPUContext& context, size_t buffer_len) {
 }
 
 // CREATING REAL TEMPORARY BUFFERS
-wgpu::Buffer make_real_buffer(WebGPUContext& context, size_t buffer_len) {
-    return createBuffer(
-        context.device,
+PooledBuffer make_real_buffer(WebGPUContext& context, size_t buffer_len) {
+    return acquireBuffer(
+        context,
         nullptr,
         sizeof(float) * buffer_len,
         WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
@@ -164,20 +145,18 @@ wgpu::Buffer make_real_buffer(WebGPUContext& context, size_t buffer_len) {
 
 // APPLYING ONE GRADIENT-DESCENT STEP AND RETURNING THE MAX VOXEL UPDATE
 float apply_gradient_step(
-    std::vector<std::vector<std::vector<float>>>& volume,
-    const std::vector<std::vector<std::vector<float>>>& grad_volume,
+    Tensor3D& volume,
+    const Tensor3D& grad_volume,
     float learning_rate,
     float angle_scale
 ) {
     float max_voxel_update = 0.0f;
-    for (size_t z = 0; z < volume.size(); ++z) {
-        for (size_t row = 0; row < volume[z].size(); ++row) {
-            for (size_t col = 0; col < volume[z][row].size(); ++col) {
-                float voxel_update = learning_rate * grad_volume[z][row][col] * angle_scale;
-                max_voxel_update = std::max(max_voxel_update, std::abs(voxel_update));
-                volume[z][row][col] -= voxel_update;
-            }
-        }
+    float* voxels = volume.data();
+    const float* grads = grad_volume.data();
+    for (size_t i = 0; i < volume.size(); ++i) {
+        float voxel_update = learning_rate * grads[i] * angle_scale;
+        max_voxel_update = std::max(max_voxel_update, std::abs(voxel_update));
+        voxels[i] -= voxel_update;
     }
     return max_voxel_update;
 }
@@ -185,67 +164,58 @@ float apply_gradient_step(
 // BACKPROPAGATING ONE ANGLE THROUGH THE VOLUME
 void backpropagate_through_volume(
     WebGPUContext& context,
-    const std::vector<std::vector<std::vector<float>>>& volume,
+    const GpuVolume& volume,
     const std::vector<int>& shape,
     const std::vector<float>& res,
     float n0,
     size_t buffer_len,
     SSNPState& exit_state,
-    wgpu::Buffer& U_grad,
-    wgpu::Buffer& UD_grad,
-    std::vector<std::vector<std::vector<float>>>& grad_volume
+    PooledBuffer& U_grad,
+    PooledBuffer& UD_grad,
+    Tensor3D& grad_volume
 ) {
-    for (int z = static_cast<int>(volume.size()) - 1; z >= 0; --z) {
+    for (int z = static_cast<int>(volume.depth) - 1; z >= 0; --z) {
         // CONVERTING THE CURRENT OBJECT-EXIT FIELD BACK TO SPATIAL DOMAIN
-        wgpu::Buffer u_buffer = make_complex_buffer(context, buffer_len);
+        PooledBuffer u_buffer = make_complex_buffer(context, buffer_len);
         fft(context, u_buffer, exit_state.U, buffer_len, shape[0], shape[1], 1);
 
         // FORMING THE SCATTER ADJOINT FROM -UD_GRAD
-        wgpu::Buffer neg_UD_grad = make_complex_buffer(context, buffer_len);
+        PooledBuffer neg_UD_grad = make_complex_buffer(context, buffer_len);
         complex_scale(context, neg_UD_grad, UD_grad, buffer_len, -1.0f);
 
-        wgpu::Buffer scatter_adjoint_spatial = make_complex_buffer(context, buffer_len);
-        fft_adjoint_forward(
-            context,
-            scatter_adjoint_spatial,
-            neg_UD_grad,
-            buffer_len,
-            shape[0],
-            shape[1]
-        );
-        neg_UD_grad.release();
+        PooledBuffer scatter_adjoint_spatial = make_complex_buffer(context, buffer_len);
+        // adjoint of the forward FFT: the unnormalized inverse
+        fft(context, scatter_adjoint_spatial, neg_UD_grad, buffer_len, shape[0], shape[1], 1, false, FFTNorm::None);
+        neg_UD_grad.reset();
 
-        wgpu::Buffer slice_buffer = create_complex_slice_buffer(context, volume[static_cast<size_t>(z)]);
-        wgpu::Buffer q_buffer = make_complex_buffer(context, buffer_len);
-        scatter_factor(context, q_buffer, slice_buffer, buffer_len, res[0], 1.0f, n0);
+        BufferView slice_buffer = volume.slice(static_cast<size_t>(z));
+        PooledBuffer q_buffer = make_complex_buffer(context, buffer_len);
+        scatter_factor(context, q_buffer, slice_buffer, volume.imagSlice(static_cast<size_t>(z)), buffer_len, res[0], 1.0f, n0);
 
         // ACCUMULATING THE U_GRAD UPDATE FROM THE SCATTER TERM
-        wgpu::Buffer U_grad_update_spatial = make_complex_buffer(context, buffer_len);
-        complex_mult(context, U_grad_update_spatial, q_buffer, scatter_adjoint_spatial, buffer_len);
-        wgpu::Buffer U_grad_update = make_complex_buffer(context, buffer_len);
-        fft(context, U_grad_update, U_grad_update_spatial, buffer_len, shape[0], shape[1], 0);
+        PooledBuffer U_grad_update = make_complex_buffer(context, buffer_len);
+        complex_mult(context, U_grad_update, q_buffer, scatter_adjoint_spatial, buffer_len);
+        fft(context, U_grad_update, U_grad_update, buffer_len, shape[0], shape[1], 0); // in place
 
-        wgpu::Buffer next_U_grad = make_complex_buffer(context, buffer_len);
+        PooledBuffer next_U_grad = make_complex_buffer(context, buffer_len);
         complex_add(context, next_U_grad, U_grad, U_grad_update, buffer_len);
-        U_grad.release();
-        U_grad_update.release();
-        U_grad = next_U_grad;
+        U_grad = std::move(next_U_grad);
+        U_grad_update.reset();
 
         // ACCUMULATING THE VOLUME GRADIENT FOR THIS SLICE
-        wgpu::Buffer dq_buffer = make_real_buffer(context, buffer_len);
+        PooledBuffer dq_buffer = make_real_buffer(context, buffer_len);
         scatter_derivative(context, dq_buffer, slice_buffer, buffer_len, res[0], 1.0f, n0);
-        wgpu::Buffer dn_slice_buffer = make_real_buffer(context, buffer_len);
+        PooledBuffer dn_slice_buffer = make_real_buffer(context, buffer_len);
         volume_grad(context, dn_slice_buffer, dq_buffer, scatter_adjoint_spatial, u_buffer, buffer_len);
-        std::vector<float> dn_slice = readBack(context.device, context.queue, buffer_len, dn_slice_buffer);
+        std::vector<float> dn_slice = readBack(context, buffer_len, dn_slice_buffer);
         accumulate_slice(grad_volume, static_cast<size_t>(z), dn_slice);
 
         // UNDOING THE FORWARD SCATTER STEP BEFORE STEPPING BACKWARD
-        wgpu::Buffer q_times_u = make_complex_buffer(context, buffer_len);
-        complex_mult(context, q_times_u, q_buffer, u_buffer, buffer_len);
-        wgpu::Buffer undo_scatter_freq = make_complex_buffer(context, buffer_len);
-        fft(context, undo_scatter_freq, q_times_u, buffer_len, shape[0], shape[1], 0);
+        PooledBuffer undo_scatter_freq = make_complex_buffer(context, buffer_len);
+        complex_mult(context, undo_scatter_freq, q_buffer, u_buffer, buffer_len);
+        fft(context, undo_scatter_freq, undo_scatter_freq, buffer_len, shape[0], shape[1], 0); // in place
 
-        wgpu::Buffer restored_UD = make_complex_buffer(context, buffer_len);
+        PooledBuffer restored_UD = make_complex_buffer(context, buffer_len);
         complex_add(context, restored_UD, exit_state.UD, undo_scatter_freq, buffer_len);
 
         // REVERSING THE FORWARD DIFFRACTION STEP
@@ -264,12 +234,11 @@ void backpropagate_through_volume(
             res,
             1.0f
         );
-        release_state(exit_state);
-        exit_state = previous_state;
+        exit_state = std::move(previous_state);
 
         // PROPAGATING THE FIELD GRADIENTS BACKWARD ONE SLICE
-        wgpu::Buffer previous_U_grad = make_complex_buffer(context, buffer_len);
-        wgpu::Buffer previous_UD_grad = make_complex_buffer(context, buffer_len);
+        PooledBuffer previous_U_grad = make_complex_buffer(context, buffer_len);
+        PooledBuffer previous_UD_grad = make_complex_buffer(context, buffer_len);
         diffract_grad(
             context,
             previous_U_grad,
@@ -281,29 +250,16 @@ void backpropagate_through_volume(
             res,
             1.0f
         );
-        U_grad.release();
-        UD_grad.release();
-        U_grad = previous_U_grad;
-        UD_grad = previous_UD_grad;
-
-        slice_buffer.release();
-        q_buffer.release();
-        dq_buffer.release();
-        dn_slice_buffer.release();
-        q_times_u.release();
-        undo_scatter_freq.release();
-        restored_UD.release();
-        u_buffer.release();
-        scatter_adjoint_spatial.release();
-        U_grad_update_spatial.release();
+        U_grad = std::move(previous_U_grad);
+        UD_grad = std::move(previous_UD_grad);
     }
 }
 
 // COMPUTING ONE ANGLE'S LOSS AND VOLUME GRADIENT CONTRIBUTION
 AngleGradientResult compute_angle_gradient(
     WebGPUContext& context,
-    const std::vector<std::vector<std::vector<float>>>& volume,
-    const std::vector<std::vector<float>>& measured,
+    const GpuVolume& volume,
+    Tensor2DView measured,
     const std::vector<float>& angle,
     const std::vector<int>& shape,
     const std::vector<float>& res,
@@ -311,7 +267,7 @@ AngleGradientResult compute_angle_gradient(
     float n0,
     size_t buffer_len,
     float inv_pixels,
-    std::vector<std::vector<std::vector<float>>>& grad_volume
+    Tensor3D& grad_volume
 ) {
     // FORWARD PROPAGATION TO THE OBJECT EXIT
     SSNPState exit_state = propagate_to_object_exit(
@@ -324,66 +280,55 @@ AngleGradientResult compute_angle_gradient(
     );
 
     // PROJECTING THE OBJECT-EXIT STATE TO THE SENSOR FIELD
-    wgpu::Buffer field_buffer = project_state_to_sensor_field(
+    PooledBuffer field_buffer = project_state_to_sensor_field(
         context,
         exit_state,
         shape,
         res,
         na,
-        -static_cast<float>(volume.size()) / 2.0f
+        -static_cast<float>(volume.depth) / 2.0f
     );
 
     // COMPUTING THE MEASUREMENT LOSS FOR THIS ANGLE
-    wgpu::Buffer predicted_intensity_buffer = make_real_buffer(context, buffer_len);
+    PooledBuffer predicted_intensity_buffer = make_real_buffer(context, buffer_len);
     intense(context, predicted_intensity_buffer, field_buffer, buffer_len, true);
     std::vector<float> predicted_intensity = readBack(
-        context.device,
-        context.queue,
+        context,
         buffer_len,
         predicted_intensity_buffer
     );
     float loss = mean_squared_loss(predicted_intensity, measured);
-    predicted_intensity_buffer.release();
+    predicted_intensity_buffer.reset();
 
     // FORMING THE SENSOR-PLANE LOSS GRADIENT
-    std::vector<float> measured_flat = flatten_real_slice(measured);
-    wgpu::Buffer measured_buffer = createBuffer(
-        context.device,
-        measured_flat.data(),
+    PooledBuffer measured_buffer = acquireBuffer(
+        context,
+        measured.data(),
         sizeof(float) * buffer_len,
         WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
     );
 
-    wgpu::Buffer field_grad = make_complex_buffer(context, buffer_len);
+    PooledBuffer field_grad = make_complex_buffer(context, buffer_len);
     amplitude_grad(context, field_grad, field_buffer, measured_buffer, buffer_len, inv_pixels);
-    field_buffer.release();
-    measured_buffer.release();
+    field_buffer.reset();
+    measured_buffer.reset();
 
     // MAPPING THE SENSOR GRADIENT BACK TO THE EXIT STATE
-    wgpu::Buffer split_forward_grad = make_complex_buffer(context, buffer_len);
-    fft_adjoint_inverse(context, split_forward_grad, field_grad, buffer_len, shape[0], shape[1]);
-    field_grad.release();
-
-    wgpu::Buffer pupil_buffer = createBuffer(
-        context.device,
-        nullptr,
-        sizeof(int) * buffer_len,
-        WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
-    );
-    binary_pupil(context, pupil_buffer, shape, na, res);
-    wgpu::Buffer pupil_filtered_grad = make_complex_buffer(context, buffer_len);
-    mult(context, pupil_filtered_grad, split_forward_grad, pupil_buffer, buffer_len);
-    split_forward_grad.release();
-    pupil_buffer.release();
-
-    wgpu::Buffer U_grad = make_complex_buffer(context, buffer_len);
-    wgpu::Buffer UD_grad = make_complex_buffer(context, buffer_len);
+    // adjoint of the inverse FFT: the forward transform scaled by 1/n, with the
+    // cached pupil applied as it writes
+    PooledBuffer pupil_filtered_grad = make_complex_buffer(context, buffer_len);
+    wgpu::Buffer pupil_buffer = getPupil(context, shape, res, na);
+    fft_postmultiply(context, pupil_filtered_grad, field_grad, pupil_buffer, buffer_len, shape[0], shape[1], 0, FFTNorm::Forward);
+    field_grad.reset();
+
+    PooledBuffer U_grad = make_complex_buffer(context, buffer_len);
+    PooledBuffer UD_grad = make_complex_buffer(context, buffer_len);
     split_prop_grad(context, U_grad, UD_grad, pupil_filtered_grad, buffer_len, shape, res);
-    pupil_filtered_grad.release();
+    pupil_filtered_grad.reset();
 
     // REVERSING THE FINAL FOCAL-PLANE PROPAGATION
-    wgpu::Buffer exit_U_grad = make_complex_buffer(context, buffer_len);
-    wgpu::Buffer exit_UD_grad = make_complex_buffer(context, buffer_len);
+    PooledBuffer exit_U_grad = make_complex_buffer(context, buffer_len);
+    PooledBuffer exit_UD_grad = make_complex_buffer(context, buffer_len);
     diffract_grad(
         context,
         exit_U_grad,
@@ -393,12 +338,10 @@ AngleGradientResult compute_angle_gradient(
         buffer_len,
         shape,
         res,
-        -static_cast<float>(volume.size()) / 2.0f
+        -static_cast<float>(volume.depth) / 2.0f
     );
-    U_grad.release();
-    UD_grad.release();
-    U_grad = exit_U_grad;
-    UD_grad = exit_UD_grad;
+    U_grad = std::move(exit_U_grad);
+    UD_grad = std::move(exit_UD_grad);
 
     // BACKPROPAGATING THE EXIT-STATE GRADIENT THROUGH THE VOLUME
     backpropagate_through_volume(
@@ -415,8 +358,8 @@ AngleGradientResult compute_angle_gradient(
     );
 
     release_state(exit_state);
-    U_grad.release();
-    UD_grad.release();
+    U_grad.reset();
+    UD_grad.reset();
 
     AngleGradientResult result;
     result.loss = loss;
@@ -427,15 +370,15 @@ AngleGradientResult compute_angle_gradient(
 
 ReconstructionResult reconstruct(
     WebGPUContext& context,
-    const std::vector<std::vector<std::vector<float>>>& measured,
+    const Tensor3D& measured,
     const std::vector<std::vector<float>>& angles,
-    std::vector<std::vector<std::vector<float>>> initial_volume,
+    Tensor3D initial_volume,
     const std::vector<float>& res,
     float na,
     float n0,
     const ReconstructionOptions& options
 ) {
-    if (measured.size() != angles.size()) {
+    if (measured.depth() != angles.size()) {
         throw std::runtime_error("Measured intensity stack and angle list must have the same length.");
     }
     if (angles.empty()) {
@@ -454,26 +397,9 @@ ReconstructionResult reconstruct(
         throw std::runtime_error("print_every must be non-negative.");
     }
 
-    std::vector<int> shape = {int(initial_volume[0].size()), int(initial_volume[0][0].size())};
-    for (const auto& slice : initial_volume) {
-        if (slice.size() != static_cast<size_t>(shape[0])) {
-            throw std::runtime_error("Initial volume slices must have consistent height.");
-        }
-        for (const auto& row : slice) {
-            if (row.size() != static_cast<size_t>(shape[1])) {
-                throw std::runtime_error("Initial volume slices must have consistent width.");
-            }
-        }
-    }
-    for (const auto& image : measured) {
-        if (image.size() != static_cast<size_t>(shape[0])) {
-            throw std::runtime_error("Measured images must match the volume height.");
-        }
-        for (const auto& row : image) {
-            if (row.size() != static_cast<size_t>(shape[1])) {
-                throw std::runtime_error("Measured images must match the volume width.");
-            }
-        }
+    std::vector<int> shape = {int(initial_volume.rows()), int(initial_volume.cols())};
+    if (measured.rows() != initial_volume.rows() || measured.cols() != initial_volume.cols()) {
+        throw std::runtime_error("Measured images must match the volume height and width.");
     }
 
     size_t buffer_len = static_cast<size_t>(shape[0]) * static_cast<size_t>(shape[1]);
@@ -488,17 +414,21 @@ ReconstructionResult reconstruct(
     float previous_loss = std::numeric_limits<float>::infinity();
     int stalled_iterations = 0;
 
+    // KEEPING THE VOLUME ON THE DEVICE ACROSS ANGLES AND ITERATIONS
+    GpuVolume gpu_volume = uploadVolume(context, result.volume);
+
     // RUNNING THE OUTER GRADIENT-DESCENT LOOP
     for (int iter = 0; iter < options.max_iterations; ++iter) {
-        std::vector<std::vector<std::vector<float>>> grad_volume = zeros_like(result.volume);
+        Tensor3D grad_volume(result.volume.depth(), result.volume.rows(), result.volume.cols());
         float total_loss = 0.0f;
 
         // ACCUMULATING LOSS AND GRADIENTS OVER ANGLES
         for (size_t angle_idx = 0; angle_idx < angles.size(); ++angle_idx) {
+            GpuStreamScope stream(context);
             AngleGradientResult angle_result = compute_angle_gradient(
                 context,
-                result.volume,
-                measured[angle_idx],
+                gpu_volume,
+                measured.slice(angle_idx),
                 angles[angle_idx],
                 shape,
                 res,
@@ -519,9 +449,10 @@ ReconstructionResult reconstruct(
 
         float updated_loss = current_loss;
         if (max_voxel_update != 0.0f) {
+            updateVolume(context, gpu_volume, result.volume);
             updated_loss = compute_measurement_loss(
                 context,
-                result.volume,
+                gpu_volume,
                 measured,
                 angles,
                 shape,
@@ -568,14 +499,15 @@ ReconstructionResult reconstruct(
         }
     }
 
+    trimBufferPool(context);
     return result;
 }
 
 ReconstructionResult reconstruct(
     WebGPUContext& context,
-    const std::vector<std::vector<std::vector<float>>>& measured,
+    const Tensor3D& measured,
     const std::vector<std::vector<float>>& angles,
-    std::vector<std::vector<std::vector<float>>> initial_volume,
+    Tensor3D initial_volume,
     const std::vector<float>& res,
     float na,
     float n0,
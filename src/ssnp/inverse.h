@@ -24,7 +24,7 @@ struct ReconstructionOptions {
 };
 
 struct ReconstructionResult {
-    std::vector<std::vector<std::vector<float>>> volume;
+    Tensor3D volume;
     std::vector<float> loss_history;
     float best_loss = 0.0f;
     float final_loss = 0.0f;
@@ -34,9 +34,9 @@ struct ReconstructionResult {
 
 ReconstructionResult reconstruct(
     WebGPUContext& context,
-    const std::vector<std::vector<std::vector<float>>>& measured,
+    const Tensor3D& measured,
     const std::vector<std::vector<float>>& angles,
-    std::vector<std::vector<std::vector<float>>> initial_volume,
+    Tensor3D initial_volume,
     const std::vector<float>& res,
     float na,
     float n0,
@@ -45,9 +45,9 @@ ReconstructionResult reconstruct(
 
 ReconstructionResult reconstruct(
     WebGPUContext& context,
-    const std::vector<std::vector<std::vector<float>>>& measured,
+    const Tensor3D& measured,
     const std::vector<std::vector<float>>& angles,
-    std::vector<std::vector<std::vector<float>>> initial_volume,
+    Tensor3D initial_volume,
     const std::vector<float>& res,
     float na,
     float n0,
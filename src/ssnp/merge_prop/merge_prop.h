@@ -9,8 +9,9 @@
 #include <optional>
 #include <webgpu/webgpu.hpp>
 #include "../../common/webgpu_utils.h"
-#include "../../common/c_gamma/c_gamma.h"
+#include "../propagator/propagator.h"
 
+// The merged U/UD may be stored in f16 (see FieldStorage)
 void merge_prop(
     WebGPUContext& context,
     wgpu::Buffer& newUFBuffer,
@@ -19,7 +20,8 @@ void merge_prop(
     wgpu::Buffer& ubBuffer,
     size_t bufferlen,
     std::vector<int> shape,
-    std::optional<std::vector<float>> res = std::vector<float>{0.1, 0.1, 0.1}
+    std::optional<std::vector<float>> res = std::vector<float>{0.1, 0.1, 0.1},
+    FieldStorage outputStorage = FieldStorage::F32
 );
 
 #endif
\ No newline at end of file
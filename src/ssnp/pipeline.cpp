@@ -2,37 +2,14 @@
 
 namespace ssnp {
 
-// FLATTENING A REAL SLICE FOR GPU UPLOAD
-std::vector<float> flatten_real_slice(const std::vector<std::vector<float>>& slice) {
-    std::vector<float> flatSlice;
-    for (const auto& row : slice) {
-        flatSlice.insert(flatSlice.end(), row.begin(), row.end());
-    }
-    return flatSlice;
-}
-
-// CREATING A COMPLEX BUFFER FROM A REAL SLICE
-wgpu::Buffer create_complex_slice_buffer(WebGPUContext& context, const std::vector<std::vector<float>>& slice) {
-    std::vector<float> flatSlice = flatten_real_slice(slice);
-    std::vector<float> complexSlice;
-    complexSlice.reserve(flatSlice.size() * 2);
-    for (float value : flatSlice) {
-        complexSlice.push_back(value);
-        complexSlice.push_back(0.0f);
-    }
-
-    return createBuffer(
-        context.device,
-        complexSlice.data(),
-        sizeof(float) * complexSlice.size(),
-        WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
-    );
-}
-
 // RELEASING SSNP STATE BUFFERS
 void release_state(SSNPState& state) {
-    state.U.release();
-    state.UD.release();
+    state.U.reset();
+    state.UD.reset();
+}
+
+FFTNorm state_norm(FieldStorage storage) {
+    return storage == FieldStorage::F16 ? FFTNorm::Ortho : FFTNorm::Backward;
 }
 
 // INITIALIZING THE INCIDENT SSNP STATE FOR ONE ANGLE
@@ -40,43 +17,42 @@ SSNPState initialize_angle_state(
     WebGPUContext& context,
     const std::vector<float>& c_ba,
     const std::vector<int>& shape,
-    const std::vector<float>& res
+    const std::vector<float>& res,
+    FieldStorage storage
 ) {
     size_t buffer_len = static_cast<size_t>(shape[0]) * static_cast<size_t>(shape[1]);
+    // merge_prop reads its input spectra as f32 whatever the state storage
+    uint64_t spectrum_bytes = fieldBytes(FieldStorage::F32, buffer_len);
 
-    wgpu::Buffer tiltResultBuffer = createBuffer(
-        context.device,
+    PooledBuffer forwardBuffer = acquireBuffer(
+        context,
         nullptr,
-        sizeof(float) * buffer_len * 2,
+        spectrum_bytes,
         WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
     );
-    tilt(context, tiltResultBuffer, c_ba, shape, res);
+    tilt(context, forwardBuffer, c_ba, shape, res);
 
-    wgpu::Buffer forwardBuffer = createBuffer(
-        context.device,
-        nullptr,
-        sizeof(float) * buffer_len * 2,
-        WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
-    );
-    fft(context, forwardBuffer, tiltResultBuffer, buffer_len, shape[0], shape[1], 0);
-    tiltResultBuffer.release();
+    // the tilted field becomes the forward spectrum in place
+    fft(context, forwardBuffer, forwardBuffer, buffer_len, shape[0], shape[1], 0, false, state_norm(storage));
 
-    std::vector<float> backward(buffer_len * 2, 0.0f);
-    wgpu::Buffer backwardBuffer = createBuffer(
-        context.device,
-        backward.data(),
-        sizeof(float) * buffer_len * 2,
+    // the incident field has no backward component; zero it on the stream
+    PooledBuffer backwardBuffer = acquireBuffer(
+        context,
+        nullptr,
+        spectrum_bytes,
         WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
     );
+    clearBuffer(context, backwardBuffer, 0, spectrum_bytes);
 
     SSNPState state = {
-        createBuffer(context.device, nullptr, sizeof(float) * buffer_len * 2, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)),
-        createBuffer(context.device, nullptr, sizeof(float) * buffer_len * 2, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc))
+        acquireBuffer(context, nullptr, fieldBytes(storage, buffer_len), WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)),
+        acquireBuffer(context, nullptr, fieldBytes(storage, buffer_len), WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)),
+        storage
     };
-    merge_prop(context, state.U, state.UD, forwardBuffer, backwardBuffer, buffer_len, shape, res);
+    merge_prop(context, state.U, state.UD, forwardBuffer, backwardBuffer, buffer_len, shape, res, storage);
 
-    forwardBuffer.release();
-    backwardBuffer.release();
+    forwardBuffer.reset();
+    backwardBuffer.reset();
     return state;
 }
 
@@ -84,59 +60,59 @@ SSNPState initialize_angle_state(
 SSNPState propagate_to_object_exit(
     WebGPUContext& context,
     SSNPState state,
-    const std::vector<std::vector<std::vector<float>>>& n,
+    const GpuVolume& n,
     const std::vector<int>& shape,
     const std::vector<float>& res,
     float n0
 ) {
     size_t buffer_len = static_cast<size_t>(shape[0]) * static_cast<size_t>(shape[1]);
+    FieldStorage storage = state.storage;
 
-    for (const auto& slice : n) {
+    // Fields crossing slices stay in the state's storage; per-slice temporaries are f32
+    for (size_t z = 0; z < n.depth; z++) {
         SSNPState diffracted = {
-            createBuffer(context.device, nullptr, sizeof(float) * buffer_len * 2, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)),
-            createBuffer(context.device, nullptr, sizeof(float) * buffer_len * 2, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc))
+            acquireBuffer(context, nullptr, fieldBytes(storage, buffer_len), WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)),
+            acquireBuffer(context, nullptr, fieldBytes(storage, buffer_len), WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)),
+            storage
         };
-        diffract(context, diffracted.U, diffracted.UD, state.U, state.UD, buffer_len, shape, res, 1.0f);
+        diffract(context, diffracted.U, diffracted.UD, state.U, state.UD, buffer_len, shape, res, 1.0f, storage, storage);
         release_state(state);
 
-        wgpu::Buffer uBuffer = createBuffer(
-            context.device,
+        PooledBuffer uBuffer = acquireBuffer(
+            context,
             nullptr,
             sizeof(float) * buffer_len * 2,
             WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
         );
-        fft(context, uBuffer, diffracted.U, buffer_len, shape[0], shape[1], 1);
+        fft(context, uBuffer, diffracted.U, buffer_len, shape[0], shape[1], 1, false, state_norm(storage), storage, FieldStorage::F32);
 
-        wgpu::Buffer sliceBuffer = create_complex_slice_buffer(context, slice);
-        wgpu::Buffer scatterBuffer = createBuffer(
-            context.device,
+        PooledBuffer scatterBuffer = acquireBuffer(
+            context,
             nullptr,
             sizeof(float) * buffer_len * 2,
             WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
         );
-        scatter_factor(context, scatterBuffer, sliceBuffer, buffer_len, res[0], 1.0f, n0);
+        scatter_factor(context, scatterBuffer, n.slice(z), n.imagSlice(z), buffer_len, res[0], 1.0f, n0);
 
-        wgpu::Buffer scatteredUD = createBuffer(
-            context.device,
+        PooledBuffer scatteredUD = acquireBuffer(
+            context,
             nullptr,
-            sizeof(float) * buffer_len * 2,
+            fieldBytes(storage, buffer_len),
             WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
         );
-        scatter_effects(context, scatteredUD, scatterBuffer, uBuffer, diffracted.UD, buffer_len, shape);
+        scatter_effects(context, scatteredUD, scatterBuffer, uBuffer, diffracted.UD, buffer_len, shape, storage, state_norm(storage));
 
-        uBuffer.release();
-        sliceBuffer.release();
-        scatterBuffer.release();
-        diffracted.UD.release();
+        state = {std::move(diffracted.U), std::move(scatteredUD), storage};
 
-        state = {diffracted.U, scatteredUD};
+        // Submitting once per slice keeps the slice temporaries short-lived
+        flushStream(context);
     }
 
     return state;
 }
 
 // PROJECTING AN OBJECT-EXIT STATE TO THE SENSOR FIELD
-wgpu::Buffer project_state_to_sensor_field(
+PooledBuffer project_state_to_sensor_field(
     WebGPUContext& context,
     const SSNPState& state,
     const std::vector<int>& shape,
@@ -147,19 +123,21 @@ wgpu::Buffer project_state_to_sensor_field(
     size_t buffer_len = static_cast<size_t>(shape[0]) * static_cast<size_t>(shape[1]);
 
     SSNPState focalState = {
-        createBuffer(context.device, nullptr, sizeof(float) * buffer_len * 2, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)),
-        createBuffer(context.device, nullptr, sizeof(float) * buffer_len * 2, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc))
+        acquireBuffer(context, nullptr, sizeof(float) * buffer_len * 2, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)),
+        acquireBuffer(context, nullptr, sizeof(float) * buffer_len * 2, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc))
     };
-    diffract(context, focalState.U, focalState.UD, const_cast<wgpu::Buffer&>(state.U), const_cast<wgpu::Buffer&>(state.UD), buffer_len, shape, res, focal_offset);
+    // the focal state is f32 from here on, whatever the storage of the exit state; it
+    // keeps the exit state's spectrum normalization, undone by the last inverse FFT
+    diffract(context, focalState.U, focalState.UD, const_cast<PooledBuffer&>(state.U), const_cast<PooledBuffer&>(state.UD), buffer_len, shape, res, focal_offset, state.storage, FieldStorage::F32);
 
-    wgpu::Buffer forwardBuffer = createBuffer(
-        context.device,
+    PooledBuffer forwardBuffer = acquireBuffer(
+        context,
         nullptr,
         sizeof(float) * buffer_len * 2,
         WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
     );
-    wgpu::Buffer backwardBuffer = createBuffer(
-        context.device,
+    PooledBuffer backwardBuffer = acquireBuffer(
+        context,
         nullptr,
         sizeof(float) * buffer_len * 2,
         WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
@@ -167,37 +145,21 @@ wgpu::Buffer project_state_to_sensor_field(
     split_prop(context, forwardBuffer, backwardBuffer, focalState.U, focalState.UD, buffer_len, shape, res);
 
     release_state(focalState);
-    backwardBuffer.release();
-
-    wgpu::Buffer pupilBuffer = createBuffer(
-        context.device,
-        nullptr,
-        sizeof(int) * buffer_len,
-        WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
-    );
-    binary_pupil(context, pupilBuffer, shape, na, res);
+    backwardBuffer.reset();
 
-    wgpu::Buffer filteredForward = createBuffer(
-        context.device,
+    PooledBuffer sensorField = acquireBuffer(
+        context,
         nullptr,
         sizeof(float) * buffer_len * 2,
         WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
     );
-    mult(context, filteredForward, forwardBuffer, pupilBuffer, buffer_len);
 
-    forwardBuffer.release();
-    pupilBuffer.release();
-
-    wgpu::Buffer fieldBuffer = createBuffer(
-        context.device,
-        nullptr,
-        sizeof(float) * buffer_len * 2,
-        WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc)
-    );
-    fft(context, fieldBuffer, filteredForward, buffer_len, shape[0], shape[1], 1);
-    filteredForward.release();
+    // back to the sensor field, with the cached pupil applied as the inverse FFT reads
+    wgpu::Buffer pupilBuffer = getPupil(context, shape, res, na);
+    fft_premultiply(context, sensorField, forwardBuffer, pupilBuffer, buffer_len, shape[0], shape[1], 1, state_norm(state.storage));
+    forwardBuffer.reset();
 
-    return fieldBuffer;
+    return sensorField;
 }
 
 }
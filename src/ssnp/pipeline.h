@@ -3,41 +3,44 @@
 
 #include "scatter_factor/scatter_factor.h"
 #include "ssnp_diffract/ssnp_diffract.h"
-#include "../common/binary_pupil/binary_pupil.h"
+#include "propagator/propagator.h"
 #include "../common/tilt/tilt.h"
 #include "merge_prop/merge_prop.h"
 #include "split_prop/split_prop.h"
 #include "../common/fft/fft.h"
-#include "../common/mult/mult.h"
 #include "scatter_effects/scatter_effects.h"
 #include "../common/intensity/intensity.h"
 #include "../common/webgpu_utils.h"
+#include "../common/gpu_volume.h"
 #include <vector>
 
 namespace ssnp {
 
+// U and UD between slices, in the storage precision they were created with
 struct SSNPState {
-    wgpu::Buffer U;
-    wgpu::Buffer UD;
+    PooledBuffer U;
+    PooledBuffer UD;
+    FieldStorage storage = FieldStorage::F32;
 };
 
 SSNPState initialize_angle_state(
     WebGPUContext& context,
     const std::vector<float>& c_ba,
     const std::vector<int>& shape,
-    const std::vector<float>& res
+    const std::vector<float>& res,
+    FieldStorage storage = FieldStorage::F32
 );
 
 SSNPState propagate_to_object_exit(
     WebGPUContext& context,
     SSNPState state,
-    const std::vector<std::vector<std::vector<float>>>& n,
+    const GpuVolume& n,
     const std::vector<int>& shape,
     const std::vector<float>& res,
     float n0
 );
 
-wgpu::Buffer project_state_to_sensor_field(
+PooledBuffer project_state_to_sensor_field(
     WebGPUContext& context,
     const SSNPState& state,
     const std::vector<int>& shape,
@@ -46,10 +49,14 @@ wgpu::Buffer project_state_to_sensor_field(
     float focal_offset
 );
 
-std::vector<float> flatten_real_slice(const std::vector<std::vector<float>>& slice);
-wgpu::Buffer create_complex_slice_buffer(WebGPUContext& context, const std::vector<std::vector<float>>& slice);
 void release_state(SSNPState& state);
 
+// Normalization of the state's spectra. An unscaled forward transform puts a unit plane
+// wave's DC bin at rows * cols, which overflows f16 (max 65504) from 256 x 256 on; the
+// orthonormal transform keeps it at sqrt(rows * cols). Every FFT into or out of the
+// state uses this mode in both directions, so the two stay an inverse pair.
+FFTNorm state_norm(FieldStorage storage);
+
 }
 
 #endif
@@ -0,0 +1,109 @@
+#include "propagator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+
+// Exact bit patterns, so nearby resolutions or slice steps never share a table
+static std::string floatBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return std::to_string(bits);
+}
+
+static std::string propagatorKey(const char* kind, const std::vector<int>& shape, const std::vector<float>& res, float dz) {
+    std::string key = std::string(kind) + "|" + std::to_string(shape[0]) + "x" + std::to_string(shape[1]);
+    for (float r : res) {
+        key += "|" + floatBits(r);
+    }
+    return key + "|" + floatBits(dz);
+}
+
+// cos(angle) of the plane wave at each pixel, as the c_gamma kernel computes it
+static std::vector<double> cosineGamma(const std::vector<int>& shape, const std::vector<float>& res) {
+    auto near0 = [](int index, int size) {
+        double x = double(index) / double(size) + 0.5;
+        return x - std::floor(x) - 0.5;
+    };
+
+    std::vector<double> gamma(static_cast<size_t>(shape[0]) * shape[1]);
+    for (int x = 0; x < shape[0]; x++) {
+        double beta = near0(x, shape[0]) / res[1];
+        for (int y = 0; y < shape[1]; y++) {
+            double alpha = near0(y, shape[1]) / res[2];
+            gamma[size_t(x) * shape[1] + y] = std::sqrt(std::max(1.0 - (alpha * alpha + beta * beta), 1e-8));
+        }
+    }
+    return gamma;
+}
+
+static wgpu::Buffer uploadTable(WebGPUContext& context, const std::string& key, const std::vector<float>& table) {
+    wgpu::Buffer buffer = createBuffer(context.device, table.data(), sizeof(float) * table.size(), wgpu::BufferUsage::Storage);
+    context.propagators.emplace(key, buffer);
+    return buffer;
+}
+
+wgpu::Buffer getPropagator(WebGPUContext& context, const std::vector<int>& shape, const std::vector<float>& res, float dz) {
+    std::string key = propagatorKey("P", shape, res, dz);
+    auto it = context.propagators.find(key);
+    if (it != context.propagators.end()) {
+        return it->second;
+    }
+
+    const double pi = std::acos(-1.0);
+    std::vector<double> gamma = cosineGamma(shape, res);
+    std::vector<float> table(4 * gamma.size());
+    for (size_t i = 0; i < gamma.size(); i++) {
+        double kz = 2.0 * pi * res[0] * gamma[i];
+        double eva = std::exp(std::clamp((gamma[i] - 0.2) * 5.0, -60.0, 0.0));
+        double c = std::cos(kz * dz) * eva;
+        double s = std::sin(kz * dz) * eva;
+        table[4 * i] = float(c);
+        table[4 * i + 1] = float(s / std::max(kz, 1e-6));
+        table[4 * i + 2] = float(-s * kz);
+        table[4 * i + 3] = float(c);
+    }
+    return uploadTable(context, key, table);
+}
+
+wgpu::Buffer getPropagatorKz(WebGPUContext& context, const std::vector<int>& shape, const std::vector<float>& res) {
+    std::string key = propagatorKey("kz", shape, res, 0.0f);
+    auto it = context.propagators.find(key);
+    if (it != context.propagators.end()) {
+        return it->second;
+    }
+
+    const double pi = std::acos(-1.0);
+    std::vector<double> gamma = cosineGamma(shape, res);
+    std::vector<float> table(gamma.size());
+    for (size_t i = 0; i < gamma.size(); i++) {
+        table[i] = float(2.0 * pi * res[2] * gamma[i]);
+    }
+    return uploadTable(context, key, table);
+}
+
+wgpu::Buffer getPupil(WebGPUContext& context, const std::vector<int>& shape, const std::vector<float>& res, float na) {
+    std::string key = propagatorKey("pupil", shape, res, na);
+    auto it = context.propagators.find(key);
+    if (it != context.propagators.end()) {
+        return it->second;
+    }
+
+    // compared in f32 like the binary_pupil kernel, so the edge pixels agree
+    float threshold = std::sqrt(1.0f - na * na);
+    std::vector<double> gamma = cosineGamma(shape, res);
+    std::vector<float> table(2 * gamma.size(), 0.0f);
+    for (size_t i = 0; i < gamma.size(); i++) {
+        table[2 * i] = float(gamma[i]) > threshold ? 1.0f : 0.0f;
+    }
+    return uploadTable(context, key, table);
+}
+
+void releasePropagators(WebGPUContext& context) {
+    flushStream(context);
+    for (auto& [key, buffer] : context.propagators) {
+        buffer.release();
+    }
+    context.propagators.clear();
+}
@@ -0,0 +1,26 @@
+#ifndef SSNP_PROPAGATOR_H
+#define SSNP_PROPAGATOR_H
+
+#include <webgpu/webgpu.hpp>
+#include "../../common/webgpu_utils.h"
+#include <vector>
+
+// Read-only per-pixel tables of the SSNP propagation and detection, evaluated in double precision
+// on the host and uploaded on first use for a given shape and resolution. Both cover
+// one shape[0] x shape[1] field; kernels index them modulo their length so batches of
+// fields share one table. The context owns the buffers.
+
+// 2x2 propagator P(kx, ky, dz) as vec4 (P00, P01, P10, P11) with
+// [U, UD](z + dz) = P [U, UD](z); the evanescent damping is folded into every entry
+wgpu::Buffer getPropagator(WebGPUContext& context, const std::vector<int>& shape, const std::vector<float>& res, float dz);
+
+// kz = 2π res[2] γ(kx, ky), used to split U/UD into forward and backward waves and back
+wgpu::Buffer getPropagatorKz(WebGPUContext& context, const std::vector<int>& shape, const std::vector<float>& res);
+
+// Binary NA pupil as a complex field, (1, 0) where γ > sqrt(1 - na²) and 0 elsewhere,
+// so it can be fused into an FFT as its factor (see fft_premultiply)
+wgpu::Buffer getPupil(WebGPUContext& context, const std::vector<int>& shape, const std::vector<float>& res, float na);
+
+void releasePropagators(WebGPUContext& context);
+
+#endif
@@ -7,8 +7,6 @@ struct Params {
     float n0;
 };
 
-static size_t buffer_len;
-
 // CREATING BIND GROUP AND LAYOUT
 static wgpu::BindGroupLayout createBindGroupLayout(wgpu::Device& device) {
     wgpu::BindGroupLayoutEntry inputBufferLayout = {};
@@ -39,15 +37,16 @@ static wgpu::BindGroupLayout createBindGroupLayout(wgpu::Device& device) {
 static wgpu::BindGroup createBindGroup(
     wgpu::Device& device,
     wgpu::BindGroupLayout bindGroupLayout,
-    wgpu::Buffer inputBuffer,
+    const BufferView& inputBuffer,
     wgpu::Buffer outputBuffer,
-    wgpu::Buffer uniformBuffer
+    wgpu::Buffer uniformBuffer,
+    size_t buffer_len
 ) {
     wgpu::BindGroupEntry inputEntry = {};
     inputEntry.binding = 0;
-    inputEntry.buffer = inputBuffer;
-    inputEntry.offset = 0;
-    inputEntry.size = sizeof(float) * buffer_len * 2;
+    inputEntry.buffer = inputBuffer.buffer;
+    inputEntry.offset = inputBuffer.offset;
+    inputEntry.size = sizeof(float) * buffer_len;
 
     wgpu::BindGroupEntry outputEntry = {};
     outputEntry.binding = 1;
@@ -74,39 +73,27 @@ static wgpu::BindGroup createBindGroup(
 void scatter_derivative(
     WebGPUContext& context,
     wgpu::Buffer& outputBuffer,
-    wgpu::Buffer& inputBuffer,
+    const BufferView& inputBuffer,
     size_t bufferlen,
     std::optional<float> res_z,
     std::optional<float> dz,
     std::optional<float> n0
 ) {
-    buffer_len = bufferlen;
+    size_t buffer_len = bufferlen;
     Params params = {res_z.value(), dz.value(), n0.value()};
 
     // INITIALIZING WEBGPU
     wgpu::Device device = context.device;
-    wgpu::Queue queue = context.queue;
 
     // LOADING AND COMPILING SHADER CODE
-    WorkgroupLimits limits = getWorkgroupLimits(device);
-    std::string shaderCode = readShaderFile("src/ssnp/scatter_derivative/scatter_derivative.wgsl", limits.maxWorkgroupSizeX);
-    wgpu::ShaderModule shaderModule = createShaderModule(device, shaderCode);
-    wgpu::Buffer uniformBuffer = createBuffer(device, &params, sizeof(Params), wgpu::BufferUsage::Uniform);
+    LaunchConfig launch = linearLaunch(context, buffer_len);
+    CachedPipeline cached = getComputePipeline(context, "src/ssnp/scatter_derivative/scatter_derivative.wgsl", createBindGroupLayout, launch.workgroupSizeX);
+    PooledBuffer uniformBuffer = acquireBuffer(context, &params, sizeof(Params), wgpu::BufferUsage::Uniform);
 
-    wgpu::BindGroupLayout bindGroupLayout = createBindGroupLayout(device);
-    wgpu::BindGroup bindGroup = createBindGroup(device, bindGroupLayout, inputBuffer, outputBuffer, uniformBuffer);
+    wgpu::BindGroupLayout bindGroupLayout = cached.bindGroupLayout;
+    wgpu::BindGroup bindGroup = createBindGroup(device, bindGroupLayout, inputBuffer, outputBuffer, uniformBuffer, buffer_len);
 
     // ENCODING AND DISPATCHING COMPUTE COMMANDS
-    wgpu::ComputePipeline computePipeline = createComputePipeline(device, shaderModule, bindGroupLayout);
-    uint32_t workgroupsX = std::ceil(double(buffer_len) / limits.maxWorkgroupSizeX);
-    wgpu::CommandBuffer commandBuffer = createComputeCommandBuffer(device, computePipeline, bindGroup, workgroupsX);
-    queue.submit(1, &commandBuffer);
-
-    // RELEASE RESOURCES
-    commandBuffer.release();
-    computePipeline.release();
-    bindGroup.release();
-    bindGroupLayout.release();
-    shaderModule.release();
-    uniformBuffer.release();
+    wgpu::ComputePipeline computePipeline = cached.pipeline;
+    dispatchCompute(context, computePipeline, bindGroup, launch);
 }
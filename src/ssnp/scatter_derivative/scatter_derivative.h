@@ -7,7 +7,7 @@
 void scatter_derivative(
     WebGPUContext& context,
     wgpu::Buffer& outputBuffer,
-    wgpu::Buffer& inputBuffer,
+    const BufferView& inputBuffer,
     size_t bufferlen,
     std::optional<float> res_z,
     std::optional<float> dz,
@@ -1,15 +1,15 @@
-@group(0) @binding(0) var<storage, read> input_n: array<vec2<f32>>;
+@group(0) @binding(0) var<storage, read> input_n: array<f32>;
 @group(0) @binding(1) var<storage, read_write> output_result: array<f32>;
 @group(0) @binding(2) var<uniform> params: vec3<f32>;
 
 @compute @workgroup_size({{WORKGROUP_SIZE}})
-fn main(@builtin(global_invocation_id) id: vec3<u32>) {
-    let i = id.x;
+fn main(@builtin(global_invocation_id) id: vec3<u32>, @builtin(num_workgroups) num_groups: vec3<u32>) {
+    let i = id.x + id.y * num_groups.x * {{WORKGROUP_SIZE_X}}u;
     if (i >= arrayLength(&output_result)) {
         return;
     }
 
     let pi = radians(180.0);
     let scale = 2.0 * pow(2.0 * pi * params.x / params.z, 2.0) * params.y;
-    output_result[i] = scale * (params.z + input_n[i].x);
+    output_result[i] = scale * (params.z + input_n[i]);
 }
@@ -1,7 +1,5 @@
 #include "scatter_effects.h"
 
-static size_t buffer_len;
-
 void scatter_effects(
     WebGPUContext& context, 
     wgpu::Buffer& outputBuffer, 
@@ -9,22 +7,12 @@ void scatter_effects(
     wgpu::Buffer& uBuffer, 
     wgpu::Buffer& udBuffer,
     size_t bufferlen,
-    std::vector<int> shape
+    std::vector<int> shape,
+    FieldStorage storage,
+    FFTNorm norm
 ) {
-    buffer_len = bufferlen;
-
-    // perform scatter factor * u
-    wgpu::Buffer fftInputBuffer = createBuffer(context.device, nullptr, sizeof(float) * buffer_len * 2, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc));
-    complex_mult(context, fftInputBuffer, scatterBuffer, uBuffer, buffer_len);
-
-    // perform fft(scatter*u)
-    wgpu::Buffer fftBuffer = createBuffer(context.device, nullptr, sizeof(float) * buffer_len * 2, WGPUBufferUsage(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc));
-    fft(context, fftBuffer, fftInputBuffer, buffer_len, shape[0], shape[1], 0);
-    fftInputBuffer.release();
-
-    // perform ud - fft(scatter*u)
-    complex_sub(context, outputBuffer, udBuffer, fftBuffer, buffer_len);
+    size_t buffer_len = bufferlen;
 
-    // Cleanup Resources
-    fftBuffer.release();
+    // perform ud - fft(scatter * u) without materializing the product or the transform
+    fft_multiply_subtract(context, outputBuffer, uBuffer, scatterBuffer, udBuffer, buffer_len, shape[0], shape[1], 0, norm, FieldStorage::F32, storage);
 }
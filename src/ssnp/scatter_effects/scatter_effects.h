@@ -7,9 +7,10 @@
 #include <webgpu/webgpu.hpp>
 #include "../../common/webgpu_utils.h"
 #include "../../common/fft/fft.h"
-#include "../../common/complex_mult/complex_mult.h"
-#include "../../common/complex_sub/complex_sub.h"
 
+// outputBuffer = udBuffer - fft(scatter * u); storage applies to udBuffer and outputBuffer,
+// and norm is the normalization of their spectra (see ssnp::state_norm).
+// The multiply and subtraction ride on the FFT's first and last passes (see fft_multiply_subtract).
 void scatter_effects(
     WebGPUContext& context, 
     wgpu::Buffer& outputBuffer, 
@@ -17,7 +18,9 @@ void scatter_effects(
     wgpu::Buffer& uBuffer, 
     wgpu::Buffer& udBuffer,
     size_t bufferlen,
-    std::vector<int> shape
+    std::vector<int> shape,
+    FieldStorage storage = FieldStorage::F32,
+    FFTNorm norm = FFTNorm::Backward
 );
 
 #endif 
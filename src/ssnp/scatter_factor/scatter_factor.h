@@ -11,7 +11,8 @@
 void scatter_factor(
     WebGPUContext& context, 
     wgpu::Buffer& outputBuffer, 
-    wgpu::Buffer& inputBuffer,
+    const BufferView& inputBuffer,
+    const BufferView& imagBuffer,
     size_t bufferlen,
     std::optional<float> res_z = 0.1, 
     std::optional<float> dz = 1, 
@@ -1,8 +1,5 @@
 #include "split_prop.h"
 
-static size_t buffer_len;
-static size_t res_buffer_len;
-
 // CREATING BIND GROUP LAYOUT
 static wgpu::BindGroupLayout createBindGroupLayout(wgpu::Device& device) {
     wgpu::BindGroupLayoutEntry ufBufferLayout = {};
@@ -15,37 +12,31 @@ static wgpu::BindGroupLayout createBindGroupLayout(wgpu::Device& device) {
     ubBufferLayout.visibility = wgpu::ShaderStage::Compute;
     ubBufferLayout.buffer.type = wgpu::BufferBindingType::ReadOnlyStorage;
 
-    wgpu::BindGroupLayoutEntry resBufferLayout = {};
-    resBufferLayout.binding = 2;
-    resBufferLayout.visibility = wgpu::ShaderStage::Compute;
-    resBufferLayout.buffer.type = wgpu::BufferBindingType::ReadOnlyStorage;
-
-    wgpu::BindGroupLayoutEntry cgammaBufferLayout = {};
-    cgammaBufferLayout.binding = 3;
-    cgammaBufferLayout.visibility = wgpu::ShaderStage::Compute;
-    cgammaBufferLayout.buffer.type = wgpu::BufferBindingType::ReadOnlyStorage;
+    wgpu::BindGroupLayoutEntry kzBufferLayout = {};
+    kzBufferLayout.binding = 2;
+    kzBufferLayout.visibility = wgpu::ShaderStage::Compute;
+    kzBufferLayout.buffer.type = wgpu::BufferBindingType::ReadOnlyStorage;
 
     wgpu::BindGroupLayoutEntry ufNewBufferLayout = {};
-    ufNewBufferLayout.binding = 4;
+    ufNewBufferLayout.binding = 3;
     ufNewBufferLayout.visibility = wgpu::ShaderStage::Compute;
     ufNewBufferLayout.buffer.type = wgpu::BufferBindingType::Storage;
 
     wgpu::BindGroupLayoutEntry ubNewBufferLayout = {};
-    ubNewBufferLayout.binding = 5;
+    ubNewBufferLayout.binding = 4;
     ubNewBufferLayout.visibility = wgpu::ShaderStage::Compute;
     ubNewBufferLayout.buffer.type = wgpu::BufferBindingType::Storage;
 
     wgpu::BindGroupLayoutEntry entries[] = {
         ufBufferLayout,
         ubBufferLayout,
-        resBufferLayout,
-        cgammaBufferLayout,
+        kzBufferLayout,
         ufNewBufferLayout,
         ubNewBufferLayout
     };
 
     wgpu::BindGroupLayoutDescriptor layoutDesc = {};
-    layoutDesc.entryCount = 6;
+    layoutDesc.entryCount = 5;
     layoutDesc.entries = entries;
 
     return device.createBindGroupLayout(layoutDesc);
@@ -57,10 +48,11 @@ static wgpu::BindGroup createBindGroup(
     wgpu::BindGroupLayout bindGroupLayout,
     wgpu::Buffer& ufBuffer,
     wgpu::Buffer& ubBuffer,
-    wgpu::Buffer& resBuffer,
-    wgpu::Buffer& cgammaBuffer,
+    wgpu::Buffer kzBuffer,
     wgpu::Buffer& ufNewBuffer,
-    wgpu::Buffer& ubNewBuffer
+    wgpu::Buffer& ubNewBuffer,
+    size_t buffer_len,
+    size_t field_len
 ) {
     wgpu::BindGroupEntry ufEntry = {};
     ufEntry.binding = 0;
@@ -74,26 +66,20 @@ static wgpu::BindGroup createBindGroup(
     ubEntry.offset = 0;
     ubEntry.size = sizeof(float) * 2 * buffer_len;
 
-    wgpu::BindGroupEntry resEntry = {};
-    resEntry.binding = 2;
-    resEntry.buffer = resBuffer;
-    resEntry.offset = 0;
-    resEntry.size = sizeof(float) * res_buffer_len; 
-
-    wgpu::BindGroupEntry cgammaEntry = {};
-    cgammaEntry.binding = 3;
-    cgammaEntry.buffer = cgammaBuffer;
-    cgammaEntry.offset = 0;
-    cgammaEntry.size = sizeof(float) * buffer_len;
+    wgpu::BindGroupEntry kzEntry = {};
+    kzEntry.binding = 2;
+    kzEntry.buffer = kzBuffer;
+    kzEntry.offset = 0;
+    kzEntry.size = sizeof(float) * field_len;
 
     wgpu::BindGroupEntry ufNewEntry = {};
-    ufNewEntry.binding = 4;
+    ufNewEntry.binding = 3;
     ufNewEntry.buffer = ufNewBuffer;
     ufNewEntry.offset = 0;
     ufNewEntry.size = sizeof(float) * 2 * buffer_len;
 
     wgpu::BindGroupEntry ubNewEntry = {};
-    ubNewEntry.binding = 5;
+    ubNewEntry.binding = 4;
     ubNewEntry.buffer = ubNewBuffer;
     ubNewEntry.offset = 0;
     ubNewEntry.size = sizeof(float) * 2 * buffer_len;
@@ -101,15 +87,14 @@ static wgpu::BindGroup createBindGroup(
     wgpu::BindGroupEntry entries[] = {
         ufEntry,
         ubEntry,
-        resEntry,
-        cgammaEntry,
+        kzEntry,
         ufNewEntry,
         ubNewEntry
     };
 
     wgpu::BindGroupDescriptor bindGroupDesc = {};
     bindGroupDesc.layout = bindGroupLayout;
-    bindGroupDesc.entryCount = 6;
+    bindGroupDesc.entryCount = 5;
     bindGroupDesc.entries = entries;
 
     return device.createBindGroup(bindGroupDesc);
@@ -125,50 +110,36 @@ void split_prop(
     std::vector<int> shape,
     std::optional<std::vector<float>> res
 ) {
-    buffer_len = bufferlen;
-    res_buffer_len = res.value().size();
+    size_t buffer_len = bufferlen;
+    size_t field_len = size_t(shape[0]) * shape[1];
 
     // INITIALIZING WEBGPU
     wgpu::Device device = context.device;
-    wgpu::Queue queue = context.queue;
     
     // LOADING AND COMPILING SHADER CODE
-    WorkgroupLimits limits = getWorkgroupLimits(device);
-    std::string shaderCode = readShaderFile("src/ssnp/split_prop/split_prop.wgsl", limits.maxWorkgroupSizeX);
-    wgpu::ShaderModule shaderModule = createShaderModule(device, shaderCode);
+    LaunchConfig launch = linearLaunch(context, buffer_len);
+    CachedPipeline cached = getComputePipeline(context, "src/ssnp/split_prop/split_prop.wgsl", createBindGroupLayout, launch.workgroupSizeX);
 
     // CREATING BUFFERS
-    wgpu::Buffer cgammaBuffer = createBuffer(context.device, nullptr, sizeof(float) * buffer_len, wgpu::BufferUsage::Storage);
-    c_gamma(context, cgammaBuffer, res.value(), shape);
-    wgpu::Buffer resBuffer = createBuffer(device, res.value().data(), sizeof(float)*res_buffer_len, wgpu::BufferUsage::Storage);
+    wgpu::Buffer kzBuffer = getPropagatorKz(context, shape, res.value());
 
     // CREATING BIND GROUP AND LAYOUT
-    wgpu::BindGroupLayout bindGroupLayout = createBindGroupLayout(device);
+    wgpu::BindGroupLayout bindGroupLayout = cached.bindGroupLayout;
     wgpu::BindGroup bindGroup = createBindGroup(
         device,
         bindGroupLayout,
         ufBuffer,
         ubBuffer,
-        resBuffer,
-        cgammaBuffer,
+        kzBuffer,
         ufNewBuffer,
-        ubNewBuffer
+        ubNewBuffer,
+        buffer_len,
+        field_len
     );
 
     // CREATING COMPUTE PIPELINE
-    wgpu::ComputePipeline computePipeline = createComputePipeline(device, shaderModule, bindGroupLayout);
+    wgpu::ComputePipeline computePipeline = cached.pipeline;
 
     // ENCODING AND DISPATCHING COMPUTE COMMANDS
-    uint32_t workgroupsX = std::ceil(double(buffer_len)/limits.maxWorkgroupSizeX);
-    wgpu::CommandBuffer commandBuffer = createComputeCommandBuffer(device, computePipeline, bindGroup, workgroupsX);
-    queue.submit(1, &commandBuffer);
-
-    // RELEASE RESOURCES
-    commandBuffer.release();
-    computePipeline.release();
-    bindGroup.release();
-    bindGroupLayout.release();
-    shaderModule.release();
-    cgammaBuffer.release();
-    resBuffer.release();
+    dispatchCompute(context, computePipeline, bindGroup, launch);
 }
\ No newline at end of file
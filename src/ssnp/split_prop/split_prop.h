@@ -9,7 +9,7 @@
 #include <optional>
 #include <webgpu/webgpu.hpp>
 #include "../../common/webgpu_utils.h"
-#include "../../common/c_gamma/c_gamma.h"
+#include "../propagator/propagator.h"
 
 void split_prop(
     WebGPUContext& context,
@@ -1,19 +1,17 @@
 @group(0) @binding(0) var<storage, read> uf : array<vec2<f32>>;
 @group(0) @binding(1) var<storage, read> ub : array<vec2<f32>>;
-@group(0) @binding(2) var<storage, read> res : array<f32>;
-@group(0) @binding(3) var<storage, read> cgamma : array<f32>;
-@group(0) @binding(4) var<storage, read_write> uf_new : array<vec2<f32>>;
-@group(0) @binding(5) var<storage, read_write> ub_new : array<vec2<f32>>;
+@group(0) @binding(2) var<storage, read> kz_table : array<f32>; // kz per pixel of one field
+@group(0) @binding(3) var<storage, read_write> uf_new : array<vec2<f32>>;
+@group(0) @binding(4) var<storage, read_write> ub_new : array<vec2<f32>>;
 
 @compute @workgroup_size({{WORKGROUP_SIZE}})
-fn main(@builtin(global_invocation_id) global_id : vec3<u32>) {
-    let idx = global_id.x;
+fn main(@builtin(global_invocation_id) global_id: vec3<u32>, @builtin(num_workgroups) num_groups: vec3<u32>) {
+    let idx = global_id.x + global_id.y * num_groups.x * {{WORKGROUP_SIZE_X}}u;
     if (idx >= arrayLength(&uf)) {
         return;
     }
 
-    let pi = radians(180.0); 
-    let kz = cgamma[idx] * (2.0 * pi * res[2]);
+    let kz = kz_table[idx % arrayLength(&kz_table)];
     
     // Complex division: 1j*ub/kz
     let result = vec2<f32>(-ub[idx].y / kz, ub[idx].x / kz);
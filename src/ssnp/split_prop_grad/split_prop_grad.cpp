@@ -1,9 +1,6 @@
 #include "split_prop_grad.h"
 #include <cmath>
 
-static size_t buffer_len;
-static size_t res_buffer_len;
-
 // CREATING BIND GROUP AND LAYOUT
 static wgpu::BindGroupLayout createBindGroupLayout(wgpu::Device& device) {
     wgpu::BindGroupLayoutEntry inputBufferLayout = {};
@@ -11,30 +8,25 @@ static wgpu::BindGroupLayout createBindGroupLayout(wgpu::Device& device) {
     inputBufferLayout.visibility = wgpu::ShaderStage::Compute;
     inputBufferLayout.buffer.type = wgpu::BufferBindingType::ReadOnlyStorage;
 
-    wgpu::BindGroupLayoutEntry resBufferLayout = {};
-    resBufferLayout.binding = 1;
-    resBufferLayout.visibility = wgpu::ShaderStage::Compute;
-    resBufferLayout.buffer.type = wgpu::BufferBindingType::ReadOnlyStorage;
-
-    wgpu::BindGroupLayoutEntry cgammaBufferLayout = {};
-    cgammaBufferLayout.binding = 2;
-    cgammaBufferLayout.visibility = wgpu::ShaderStage::Compute;
-    cgammaBufferLayout.buffer.type = wgpu::BufferBindingType::ReadOnlyStorage;
+    wgpu::BindGroupLayoutEntry kzBufferLayout = {};
+    kzBufferLayout.binding = 1;
+    kzBufferLayout.visibility = wgpu::ShaderStage::Compute;
+    kzBufferLayout.buffer.type = wgpu::BufferBindingType::ReadOnlyStorage;
 
     wgpu::BindGroupLayoutEntry uGradBufferLayout = {};
-    uGradBufferLayout.binding = 3;
+    uGradBufferLayout.binding = 2;
     uGradBufferLayout.visibility = wgpu::ShaderStage::Compute;
     uGradBufferLayout.buffer.type = wgpu::BufferBindingType::Storage;
 
     wgpu::BindGroupLayoutEntry udGradBufferLayout = {};
-    udGradBufferLayout.binding = 4;
+    udGradBufferLayout.binding = 3;
     udGradBufferLayout.visibility = wgpu::ShaderStage::Compute;
     udGradBufferLayout.buffer.type = wgpu::BufferBindingType::Storage;
 
-    wgpu::BindGroupLayoutEntry entries[] = {inputBufferLayout, resBufferLayout, cgammaBufferLayout, uGradBufferLayout, udGradBufferLayout};
+    wgpu::BindGroupLayoutEntry entries[] = {inputBufferLayout, kzBufferLayout, uGradBufferLayout, udGradBufferLayout};
 
     wgpu::BindGroupLayoutDescriptor layoutDesc = {};
-    layoutDesc.entryCount = 5;
+    layoutDesc.entryCount = 4;
     layoutDesc.entries = entries;
 
     return device.createBindGroupLayout(layoutDesc);
@@ -45,10 +37,11 @@ static wgpu::BindGroup createBindGroup(
     wgpu::Device& device,
     wgpu::BindGroupLayout bindGroupLayout,
     wgpu::Buffer inputBuffer,
-    wgpu::Buffer resBuffer,
-    wgpu::Buffer cgammaBuffer,
+    wgpu::Buffer kzBuffer,
     wgpu::Buffer uGradBuffer,
-    wgpu::Buffer udGradBuffer
+    wgpu::Buffer udGradBuffer,
+    size_t buffer_len,
+    size_t field_len
 ) {
     wgpu::BindGroupEntry inputEntry = {};
     inputEntry.binding = 0;
@@ -56,35 +49,29 @@ static wgpu::BindGroup createBindGroup(
     inputEntry.offset = 0;
     inputEntry.size = sizeof(float) * 2 * buffer_len;
 
-    wgpu::BindGroupEntry resEntry = {};
-    resEntry.binding = 1;
-    resEntry.buffer = resBuffer;
-    resEntry.offset = 0;
-    resEntry.size = sizeof(float) * res_buffer_len;
-
-    wgpu::BindGroupEntry cgammaEntry = {};
-    cgammaEntry.binding = 2;
-    cgammaEntry.buffer = cgammaBuffer;
-    cgammaEntry.offset = 0;
-    cgammaEntry.size = sizeof(float) * buffer_len;
+    wgpu::BindGroupEntry kzEntry = {};
+    kzEntry.binding = 1;
+    kzEntry.buffer = kzBuffer;
+    kzEntry.offset = 0;
+    kzEntry.size = sizeof(float) * field_len;
 
     wgpu::BindGroupEntry uGradEntry = {};
-    uGradEntry.binding = 3;
+    uGradEntry.binding = 2;
     uGradEntry.buffer = uGradBuffer;
     uGradEntry.offset = 0;
     uGradEntry.size = sizeof(float) * 2 * buffer_len;
 
     wgpu::BindGroupEntry udGradEntry = {};
-    udGradEntry.binding = 4;
+    udGradEntry.binding = 3;
     udGradEntry.buffer = udGradBuffer;
     udGradEntry.offset = 0;
     udGradEntry.size = sizeof(float) * 2 * buffer_len;
 
-    wgpu::BindGroupEntry entries[] = {inputEntry, resEntry, cgammaEntry, uGradEntry, udGradEntry};
+    wgpu::BindGroupEntry entries[] = {inputEntry, kzEntry, uGradEntry, udGradEntry};
 
     wgpu::BindGroupDescriptor bindGroupDesc = {};
     bindGroupDesc.layout = bindGroupLayout;
-    bindGroupDesc.entryCount = 5;
+    bindGroupDesc.entryCount = 4;
     bindGroupDesc.entries = entries;
 
     return device.createBindGroup(bindGroupDesc);
@@ -99,37 +86,22 @@ void split_prop_grad(
     std::vector<int> shape,
     std::optional<std::vector<float>> res
 ) {
-    buffer_len = bufferlen;
-    res_buffer_len = res.value().size();
+    size_t buffer_len = bufferlen;
+    size_t field_len = size_t(shape[0]) * shape[1];
 
     // INITIALIZING WEBGPU
     wgpu::Device device = context.device;
-    wgpu::Queue queue = context.queue;
 
     // LOADING AND COMPILING SHADER CODE
-    WorkgroupLimits limits = getWorkgroupLimits(device);
-    std::string shaderCode = readShaderFile("src/ssnp/split_prop_grad/split_prop_grad.wgsl", limits.maxWorkgroupSizeX);
-    wgpu::ShaderModule shaderModule = createShaderModule(device, shaderCode);
+    LaunchConfig launch = linearLaunch(context, buffer_len);
+    CachedPipeline cached = getComputePipeline(context, "src/ssnp/split_prop_grad/split_prop_grad.wgsl", createBindGroupLayout, launch.workgroupSizeX);
 
-    wgpu::Buffer cgammaBuffer = createBuffer(context.device, nullptr, sizeof(float) * buffer_len, wgpu::BufferUsage::Storage);
-    c_gamma(context, cgammaBuffer, res.value(), shape);
-    wgpu::Buffer resBuffer = createBuffer(device, res.value().data(), sizeof(float) * res_buffer_len, wgpu::BufferUsage::Storage);
+    wgpu::Buffer kzBuffer = getPropagatorKz(context, shape, res.value());
 
-    wgpu::BindGroupLayout bindGroupLayout = createBindGroupLayout(device);
-    wgpu::BindGroup bindGroup = createBindGroup(device, bindGroupLayout, forwardGradBuffer, resBuffer, cgammaBuffer, uGradBuffer, udGradBuffer);
+    wgpu::BindGroupLayout bindGroupLayout = cached.bindGroupLayout;
+    wgpu::BindGroup bindGroup = createBindGroup(device, bindGroupLayout, forwardGradBuffer, kzBuffer, uGradBuffer, udGradBuffer, buffer_len, field_len);
 
     // ENCODING AND DISPATCHING COMPUTE COMMANDS
-    wgpu::ComputePipeline computePipeline = createComputePipeline(device, shaderModule, bindGroupLayout);
-    uint32_t workgroupsX = std::ceil(double(buffer_len) / limits.maxWorkgroupSizeX);
-    wgpu::CommandBuffer commandBuffer = createComputeCommandBuffer(device, computePipeline, bindGroup, workgroupsX);
-    queue.submit(1, &commandBuffer);
-
-    // RELEASE RESOURCES
-    commandBuffer.release();
-    computePipeline.release();
-    bindGroup.release();
-    bindGroupLayout.release();
-    shaderModule.release();
-    cgammaBuffer.release();
-    resBuffer.release();
+    wgpu::ComputePipeline computePipeline = cached.pipeline;
+    dispatchCompute(context, computePipeline, bindGroup, launch);
 }
@@ -9,8 +9,10 @@
 #include <optional>
 #include <webgpu/webgpu.hpp>
 #include "../../common/webgpu_utils.h"
-#include "../../common/c_gamma/c_gamma.h"
+#include "../propagator/propagator.h"
 
+// Steps U/UD by dz with the cached propagator (see getPropagator). U/UD may be stored
+// in f16 on either side (see FieldStorage); the propagation runs in f32
 void diffract(
     WebGPUContext& context, 
     wgpu::Buffer& newUFBuffer, 
@@ -20,7 +22,9 @@ void diffract(
     size_t bufferlen,
     std::vector<int> shape,
     std::optional<std::vector<float>> res = std::vector<float>{0.1, 0.1, 0.1}, 
-    std::optional<float> dz = 1.0
+    std::optional<float> dz = 1.0,
+    FieldStorage inputStorage = FieldStorage::F32,
+    FieldStorage outputStorage = FieldStorage::F32
 );
 
 #endif 
\ No newline at end of file
@@ -1,52 +1,25 @@
-@group(0) @binding(0) var<storage, read> uf : array<vec2<f32>>;
-@group(0) @binding(1) var<storage, read> ub : array<vec2<f32>>;
-@group(0) @binding(2) var<storage, read> res : array<f32>;
-@group(0) @binding(3) var<storage, read> cgamma : array<f32>;
-@group(0) @binding(4) var<storage, read_write> newUF : array<vec2<f32>>;
-@group(0) @binding(5) var<storage, read_write> newUB : array<vec2<f32>>;
-@group(0) @binding(6) var<uniform> params: f32;
+{{ENABLE_F16}}
+
+@group(0) @binding(0) var<storage, read> uf : array<{{FIELD_IN}}>;
+@group(0) @binding(1) var<storage, read> ub : array<{{FIELD_IN}}>;
+@group(0) @binding(2) var<storage, read> propagator : array<vec4<f32>>; // (P00, P01, P10, P11) per pixel of one field
+@group(0) @binding(3) var<storage, read_write> newUF : array<{{FIELD_OUT}}>;
+@group(0) @binding(4) var<storage, read_write> newUB : array<{{FIELD_OUT}}>;
 
 @compute @workgroup_size({{WORKGROUP_SIZE}})
-fn main(@builtin(global_invocation_id) global_id : vec3<u32>) {
-    let idx = global_id.x;
+fn main(@builtin(global_invocation_id) global_id: vec3<u32>, @builtin(num_workgroups) num_groups: vec3<u32>) {
+    let idx = global_id.x + global_id.y * num_groups.x * {{WORKGROUP_SIZE_X}}u;
     if (idx >= arrayLength(&uf)) {
         return;
     }
 
-    let pi = radians(180.0);
-    let gamma = cgamma[idx];
-    let kz = 2.0 * pi * res[0] * gamma;
-
-    // Clamp exponent to prevent underflow/overflow
-    let exponent = clamp((gamma - 0.2) * 5.0, -60.0, 0.0);
-    let eva = exp(exponent);
-
-    // Trig stability: use Taylor approximation for small kz
-    let kz_dz = kz * params;
-
-    let cos_kz_dz = cos(kz_dz) * eva;
-
-    let sin_kz_dz =
-        select(sin(kz_dz), kz_dz - (kz_dz * kz_dz * kz_dz) / 6.0, abs(kz_dz) < 1e-2) * eva;
-
-    let p_mat_0 = cos_kz_dz;
-    let p_mat_1 = sin_kz_dz / max(kz, 1e-6); // avoid divide-by-zero
-    let p_mat_2 = -sin_kz_dz * kz;
-    let p_mat_3 = cos_kz_dz;
-
-    // FMA-style pattern: helps minimize rounding error
-    let uf_x = uf[idx].x;
-    let uf_y = uf[idx].y;
-    let ub_x = ub[idx].x;
-    let ub_y = ub[idx].y;
+    // The propagator is precomputed per (shape, res, dz), so a slice step is a 2x2 mat-vec
+    let p = propagator[idx % arrayLength(&propagator)];
 
-    newUF[idx] = vec2<f32>(
-        p_mat_0 * uf_x + p_mat_1 * ub_x,
-        p_mat_0 * uf_y + p_mat_1 * ub_y
-    );
+    // f16 fields widen to f32 here
+    let uf_value = vec2<f32>(uf[idx]);
+    let ub_value = vec2<f32>(ub[idx]);
 
-    newUB[idx] = vec2<f32>(
-        p_mat_2 * uf_x + p_mat_3 * ub_x,
-        p_mat_2 * uf_y + p_mat_3 * ub_y
-    );
+    newUF[idx] = {{FIELD_OUT}}(p.x * uf_value + p.y * ub_value);
+    newUB[idx] = {{FIELD_OUT}}(p.z * uf_value + p.w * ub_value);
 }
@@ -1,8 +1,6 @@
 #include "volume_grad.h"
 #include <cmath>
 
-static size_t buffer_len;
-
 // CREATING BIND GROUP AND LAYOUT
 static wgpu::BindGroupLayout createBindGroupLayout(wgpu::Device& device) {
     wgpu::BindGroupLayoutEntry dqBufferLayout = {};
@@ -41,7 +39,8 @@ static wgpu::BindGroup createBindGroup(
     wgpu::Buffer dqBuffer,
     wgpu::Buffer gradBuffer,
     wgpu::Buffer uBuffer,
-    wgpu::Buffer outputBuffer
+    wgpu::Buffer outputBuffer,
+    size_t buffer_len
 ) {
     wgpu::BindGroupEntry dqEntry = {};
     dqEntry.binding = 0;
@@ -85,30 +84,19 @@ void volume_grad(
     wgpu::Buffer& uBuffer,
     size_t bufferlen
 ) {
-    buffer_len = bufferlen;
+    size_t buffer_len = bufferlen;
 
     // INITIALIZING WEBGPU
     wgpu::Device device = context.device;
-    wgpu::Queue queue = context.queue;
 
     // LOADING AND COMPILING SHADER CODE
-    WorkgroupLimits limits = getWorkgroupLimits(device);
-    std::string shaderCode = readShaderFile("src/ssnp/volume_grad/volume_grad.wgsl", limits.maxWorkgroupSizeX);
-    wgpu::ShaderModule shaderModule = createShaderModule(device, shaderCode);
+    LaunchConfig launch = linearLaunch(context, buffer_len);
+    CachedPipeline cached = getComputePipeline(context, "src/ssnp/volume_grad/volume_grad.wgsl", createBindGroupLayout, launch.workgroupSizeX);
 
-    wgpu::BindGroupLayout bindGroupLayout = createBindGroupLayout(device);
-    wgpu::BindGroup bindGroup = createBindGroup(device, bindGroupLayout, dqBuffer, gradBuffer, uBuffer, outputBuffer);
+    wgpu::BindGroupLayout bindGroupLayout = cached.bindGroupLayout;
+    wgpu::BindGroup bindGroup = createBindGroup(device, bindGroupLayout, dqBuffer, gradBuffer, uBuffer, outputBuffer, buffer_len);
 
     // ENCODING AND DISPATCHING COMPUTE COMMANDS
-    wgpu::ComputePipeline computePipeline = createComputePipeline(device, shaderModule, bindGroupLayout);
-    uint32_t workgroupsX = std::ceil(double(buffer_len) / limits.maxWorkgroupSizeX);
-    wgpu::CommandBuffer commandBuffer = createComputeCommandBuffer(device, computePipeline, bindGroup, workgroupsX);
-    queue.submit(1, &commandBuffer);
-
-    // RELEASE RESOURCES
-    commandBuffer.release();
-    computePipeline.release();
-    bindGroup.release();
-    bindGroupLayout.release();
-    shaderModule.release();
+    wgpu::ComputePipeline computePipeline = cached.pipeline;
+    dispatchCompute(context, computePipeline, bindGroup, launch);
 }
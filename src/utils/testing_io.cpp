@@ -9,33 +9,21 @@ namespace {
 
 bool read_tensor(
     std::ifstream& in,
-    std::vector<std::vector<std::vector<float>>>& tensor,
+    Tensor3D& tensor,
     int D,
     int H,
     int W
 ) {
-    size_t total = static_cast<size_t>(D) * H * W;
-    std::vector<float> buffer(total);
-    in.read(reinterpret_cast<char*>(buffer.data()), total * sizeof(float));
-    if (!in) {
-        return false;
-    }
-
-    tensor.resize(D, std::vector<std::vector<float>>(H, std::vector<float>(W)));
-    size_t idx = 0;
-    for (int d = 0; d < D; ++d)
-        for (int i = 0; i < H; ++i)
-            for (int j = 0; j < W; ++j)
-                tensor[d][i][j] = buffer[idx++];
-
-    return true;
+    tensor = Tensor3D(D, H, W);
+    in.read(reinterpret_cast<char*>(tensor.data()), tensor.size() * sizeof(float));
+    return static_cast<bool>(in);
 }
 
 } // namespace
 
 bool read_input_tensor(
     const std::string& filename,
-    std::vector<std::vector<std::vector<float>>>& tensor,
+    Tensor3D& tensor,
     int& D,
     int& H,
     int& W
@@ -59,7 +47,7 @@ bool read_input_tensor(
 
 bool write_output_tensor(
     const std::string& filename,
-    const std::vector<std::vector<std::vector<float>>>& tensor
+    const Tensor3D& tensor
 ) {
     std::ofstream out(filename, std::ios::binary);
     if (!out) {
@@ -67,17 +55,15 @@ bool write_output_tensor(
         return false;
     }
 
-    int D = tensor.size();
-    int H = tensor[0].size();
-    int W = tensor[0][0].size();
+    int D = tensor.depth();
+    int H = tensor.rows();
+    int W = tensor.cols();
 
     out.write(reinterpret_cast<char*>(&D), sizeof(int));
     out.write(reinterpret_cast<char*>(&H), sizeof(int));
     out.write(reinterpret_cast<char*>(&W), sizeof(int));
 
-    for (int d = 0; d < D; ++d)
-        for (int i = 0; i < H; ++i)
-            out.write(reinterpret_cast<const char*>(tensor[d][i].data()), W * sizeof(float));
+    out.write(reinterpret_cast<const char*>(tensor.data()), tensor.size() * sizeof(float));
 
     return true;
 }
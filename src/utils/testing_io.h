@@ -8,9 +8,9 @@
 namespace testing_io {
 
 struct ReconstructionInput {
-    std::vector<std::vector<std::vector<float>>> measured;
+    Tensor3D measured;
     std::vector<std::vector<float>> angles;
-    std::vector<std::vector<std::vector<float>>> initial_volume;
+    Tensor3D initial_volume;
     std::vector<float> res;
     float na;
     float n0;
@@ -24,7 +24,7 @@ struct ReconstructionInput {
 
 bool read_input_tensor(
     const std::string& filename,
-    std::vector<std::vector<std::vector<float>>>& tensor,
+    Tensor3D& tensor,
     int& D,
     int& H,
     int& W
@@ -32,7 +32,7 @@ bool read_input_tensor(
 
 bool write_output_tensor(
     const std::string& filename,
-    const std::vector<std::vector<std::vector<float>>>& tensor
+    const Tensor3D& tensor
 );
 
 bool read_reconstruction_input(const std::string& filename, ReconstructionInput& input);
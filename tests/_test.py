@@ -13,6 +13,14 @@ import pytest
 SLICES = 32
 ROWS = 128
 COLS = 128
+# (slices, rows, cols) grids compared end to end: power of two, mixed radix,
+# Bluestein (prime sizes) and non-square
+SHAPES = [
+    (SLICES, ROWS, COLS),
+    (SLICES, 120, 120),
+    (SLICES, 97, 101),
+    (SLICES, 48, 80),
+]
 TOL = 1e-4 # rtol
 IMAGE_NAME = None # None if no save
 MODEL = "bpm" # for local testing
@@ -119,13 +127,13 @@ def compare_outputs(py_output, cpp_output, rtol=TOL, atol=1e-4):
         print("✅ All outputs match within specified tolerances.")
         return True
 
-def run_model_test(model):
+def run_model_test(model, shape=(SLICES, ROWS, COLS)):
     print("Building C++ model...")
     subprocess.run(["cmake", "-B", "build", "-S", "."])
     subprocess.run(["cmake", "--build", "build"])
 
     print("Generating input...")
-    input_tensor = generate_input((SLICES, ROWS, COLS))
+    input_tensor = generate_input(shape)
     save_tensor_bin("input.bin", input_tensor)
 
     print(f"Running C++ model ({model})...")
@@ -135,7 +143,8 @@ def run_model_test(model):
     py_output = run_python_model(input_tensor, model)
 
     if IMAGE_NAME is not None:
-        image_folder = f"{ROWS}x{COLS}x{SLICES}"
+        slices, rows, cols = shape
+        image_folder = f"{rows}x{cols}x{slices}"
         output_dir = f"images/{model}_out/{image_folder}/"
         print(f"Saving images to {output_dir}...")
         os.makedirs(output_dir, exist_ok=True)
@@ -152,14 +161,17 @@ def run_model_test(model):
             os.remove(file)
 
 # For pytest
-def test_ssnp():
-    run_model_test("ssnp")
+@pytest.mark.parametrize("shape", SHAPES)
+def test_ssnp(shape):
+    run_model_test("ssnp", shape)
 
-def test_bpm():
-    run_model_test("bpm")
+@pytest.mark.parametrize("shape", SHAPES)
+def test_bpm(shape):
+    run_model_test("bpm", shape)
 
-def test_born():
-    run_model_test("born")
+@pytest.mark.parametrize("shape", SHAPES)
+def test_born(shape):
+    run_model_test("born", shape)
 
 if __name__ == "__main__":
     run_model_test(MODEL)